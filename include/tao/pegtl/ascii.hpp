@@ -23,8 +23,10 @@ namespace tao::pegtl
       struct identifier_first : internal::identifier_first {};
       struct identifier_other : internal::identifier_other {};
       struct identifier : internal::identifier {};
+      template< typename... Strings > struct ikeywords : internal::keywords< true, typename Strings::rule_t... > {};
       template< char... Cs > struct istring : internal::istring< Cs... > {};
       template< char... Cs > struct keyword : internal::seq< internal::string< Cs... >, internal::not_at< internal::identifier_other > > { static_assert( sizeof...( Cs ) > 0 ); };
+      template< typename... Strings > struct keywords : internal::keywords< false, typename Strings::rule_t... > {};
       struct lower : internal::range< internal::result_on_found::success, internal::peek_char, 'a', 'z' > {};
       template< char... Cs > struct not_one : internal::one< internal::result_on_found::failure, internal::peek_char, Cs... > {};
       template< char Lo, char Hi > struct not_range : internal::range< internal::result_on_found::failure, internal::peek_char, Lo, Hi > {};
@@ -155,6 +155,11 @@ namespace tao::pegtl
       : std::conditional_t< ( sizeof...( Cs ) != 0 ), analyze_any_traits<>, analyze_opt_traits<> >
    {};
 
+   template< typename Name, bool Insensitive, typename... Strings >
+   struct analyze_traits< Name, internal::keywords< Insensitive, Strings... > >
+      : analyze_any_traits<>
+   {};
+
    template< typename Name, typename... Rules >
    struct analyze_traits< Name, internal::not_at< Rules... > >
       : analyze_traits< Name, typename opt< Rules... >::rule_t >
@@ -220,6 +225,11 @@ namespace tao::pegtl
       : analyze_sor_traits< Rule, Rules... >
    {};
 
+   template< typename Name, typename Rule, typename... Rules >
+   struct analyze_traits< Name, internal::sor_dispatch< Rule, Rules... > >
+      : analyze_sor_traits< Rule, Rules... >
+   {};
+
    template< typename Name, typename... Rules >
    struct analyze_traits< Name, internal::star< Rules... > >
       : analyze_traits< Name, typename opt< Rules..., Name >::rule_t >
@@ -251,6 +261,11 @@ namespace tao::pegtl
    {};
 
 #if defined( __cpp_exceptions )
+   template< typename Name >
+   struct analyze_traits< Name, internal::cut >
+      : analyze_opt_traits<>
+   {};
+
    template< typename Name, typename Cond, typename... Rules >
    struct analyze_traits< Name, internal::if_must< true, Cond, Rules... > >
       : analyze_traits< Name, typename opt< Cond, Rules... >::rule_t >
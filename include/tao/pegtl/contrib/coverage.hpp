@@ -8,6 +8,7 @@
 #include <cstddef>
 #include <map>
 #include <string_view>
+#include <utility>
 #include <vector>
 
 #include "state_control.hpp"
@@ -42,85 +43,131 @@ namespace tao::pegtl
 
    namespace internal
    {
-      template< typename Rule >
+      // The entry of a rule and the infos of its branches are found via its rule_id;
+      // rules that are not part of the grammar fall back to a lookup in the map.
+
+      struct coverage_slot
+      {
+         coverage_entry* entry = nullptr;
+         std::vector< std::pair< std::size_t, coverage_info* > > branches;
+      };
+
+      template< typename Grammar >
       struct coverage_insert
       {
-         static void visit( std::map< std::string_view, coverage_entry >& map )
+         template< typename Rule >
+         struct type
          {
-            visit_branches( map.try_emplace( demangle< Rule >() ).first->second.branches, typename Rule::subs_t() );
-         }
+            static void visit( coverage_result& result, std::vector< coverage_slot >& slots )
+            {
+               coverage_slot& slot = slots[ rule_id_v< Grammar, Rule > ];
+               slot.entry = &result.try_emplace( demangle< Rule >() ).first->second;
+               visit_branches( slot, typename Rule::subs_t() );
+            }
 
-         template< typename... Ts >
-         static void visit_branches( std::map< std::string_view, coverage_info >& branches, type_list< Ts... > /*unused*/ )
-         {
-            ( branches.try_emplace( demangle< Ts >() ), ... );
-         }
+            template< typename... Ts >
+            static void visit_branches( coverage_slot& slot, type_list< Ts... > /*unused*/ )
+            {
+               ( slot.branches.emplace_back( rule_id_v< Grammar, Ts >, &slot.entry->branches.try_emplace( demangle< Ts >() ).first->second ), ... );
+            }
+         };
       };
 
+      template< typename Grammar >
       struct coverage_state
       {
+         using rules_t = rule_list_t< Grammar >;
+
          template< typename Rule >
          static constexpr bool enable = true;
 
+         template< typename Rule >
+         static constexpr std::size_t rule_index_v = rule_index< Rule >( rules_t() );
+
          explicit coverage_state( coverage_result& in_result )
-            : result( in_result )
+            : result( in_result ),
+              slots( rules_t::size )
          {}
 
+         struct frame
+         {
+            std::size_t id;
+            coverage_entry* entry;
+         };
+
          coverage_result& result;
-         std::vector< std::string_view > stack;
+         std::vector< coverage_slot > slots;
+         std::vector< frame > stack;
+
+         template< typename Rule >
+         [[nodiscard]] coverage_entry& entry()
+         {
+            if constexpr( rule_index_v< Rule > < rules_t::size ) {
+               return *slots[ rule_index_v< Rule > ].entry;
+            }
+            else {
+               return result.at( demangle< Rule >() );
+            }
+         }
+
+         template< typename Rule >
+         [[nodiscard]] coverage_info* branch()
+         {
+            if( stack.empty() ) {
+               return nullptr;
+            }
+            const frame& parent = stack.back();
+            if( parent.id < slots.size() ) {
+               for( const auto& [ id, info ] : slots[ parent.id ].branches ) {
+                  if( id == rule_index_v< Rule > ) {
+                     return info;
+                  }
+               }
+            }
+            return &parent.entry->branches.at( demangle< Rule >() );
+         }
+
+         template< typename Rule >
+         void count( std::size_t coverage_info::*member )
+         {
+            ++( entry< Rule >().*member );
+            if( coverage_info* info = branch< Rule >() ) {
+               ++( info->*member );
+            }
+         }
 
          template< typename Rule, typename ParseInput, typename... States >
          void start( const ParseInput& /*unused*/, States&&... /*unused*/ )
          {
-            const auto name = demangle< Rule >();
-            ++result.at( name ).start;
-            if( !stack.empty() ) {
-               ++result.at( stack.back() ).branches.at( name ).start;
-            }
-            stack.push_back( name );
+            count< Rule >( &coverage_info::start );
+            stack.push_back( frame{ rule_index_v< Rule >, &entry< Rule >() } );
          }
 
          template< typename Rule, typename ParseInput, typename... States >
          void success( const ParseInput& /*unused*/, States&&... /*unused*/ )
          {
             stack.pop_back();
-            const auto name = demangle< Rule >();
-            ++result.at( name ).success;
-            if( !stack.empty() ) {
-               ++result.at( stack.back() ).branches.at( name ).success;
-            }
+            count< Rule >( &coverage_info::success );
          }
 
          template< typename Rule, typename ParseInput, typename... States >
          void failure( const ParseInput& /*unused*/, States&&... /*unused*/ )
          {
             stack.pop_back();
-            const auto name = demangle< Rule >();
-            ++result.at( name ).failure;
-            if( !stack.empty() ) {
-               ++result.at( stack.back() ).branches.at( name ).failure;
-            }
+            count< Rule >( &coverage_info::failure );
          }
 
          template< typename Rule, typename ParseInput, typename... States >
          void raise( const ParseInput& /*unused*/, States&&... /*unused*/ )
          {
-            const auto name = demangle< Rule >();
-            ++result.at( name ).raise;
-            if( !stack.empty() ) {
-               ++result.at( stack.back() ).branches.at( name ).raise;
-            }
+            count< Rule >( &coverage_info::raise );
          }
 
          template< typename Rule, typename ParseInput, typename... States >
          void unwind( const ParseInput& /*unused*/, States&&... /*unused*/ )
          {
             stack.pop_back();
-            const auto name = demangle< Rule >();
-            ++result.at( name ).unwind;
-            if( !stack.empty() ) {
-               ++result.at( stack.back() ).branches.at( name ).unwind;
-            }
+            count< Rule >( &coverage_info::unwind );
          }
 
          template< typename Rule, typename ParseInput, typename... States >
@@ -141,8 +188,8 @@ namespace tao::pegtl
              typename... States >
    bool coverage( ParseInput&& in, coverage_result& result, States&&... st )
    {
-      internal::coverage_state state( result );
-      visit< Rule, internal::coverage_insert >( state.result );  // Fill map with all sub-rules of the grammar.
+      internal::coverage_state< Rule > state( result );
+      visit< Rule, internal::coverage_insert< Rule >::template type >( state.result, state.slots );  // Fill map with all sub-rules of the grammar.
       return parse< Rule, Action, state_control< Control >::template type >( in, st..., state );
    }
 
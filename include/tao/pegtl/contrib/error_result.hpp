@@ -0,0 +1,184 @@
+// Copyright (c) 2023 Dr. Colin Hirsch and Daniel Frey
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef TAO_PEGTL_CONTRIB_ERROR_RESULT_HPP
+#define TAO_PEGTL_CONTRIB_ERROR_RESULT_HPP
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+
+#include "remove_last_states.hpp"
+
+#include "../apply_mode.hpp"
+#include "../demangle.hpp"
+#include "../normal.hpp"
+#include "../nothing.hpp"
+#include "../parse.hpp"
+#include "../position.hpp"
+#include "../rewind_mode.hpp"
+
+#include "../internal/has_error_message.hpp"
+
+#if defined( __cpp_exceptions )
+#include "../parse_error.hpp"
+#endif
+
+namespace tao::pegtl
+{
+   // The global error of a parse with parse_error_result(), i.e. the rule that was
+   // raised and where; the message and the position are only created on request.
+
+   template< typename ParseInput >
+   struct error_result
+   {
+      using frobnicator_t = typename ParseInput::frobnicator_t;
+
+      std::string_view ( *rule )() noexcept = nullptr;
+      const char* error_message = nullptr;
+      frobnicator_t frobnicator = frobnicator_t();
+
+      [[nodiscard]] explicit operator bool() const noexcept
+      {
+         return rule != nullptr;
+      }
+
+      template< typename Rule >
+      void set( const ParseInput& in ) noexcept
+      {
+         rule = &demangle< Rule >;
+         if constexpr( internal::has_error_message< Rule > ) {
+            error_message = Rule::error_message;
+         }
+         frobnicator = in.frobnicator();
+      }
+
+      [[nodiscard]] std::string message() const
+      {
+         if( error_message != nullptr ) {
+            return error_message;
+         }
+         return "parse error matching " + std::string( rule() );
+      }
+
+      [[nodiscard]] tao::pegtl::position position( const ParseInput& in ) const
+      {
+         return in.position( frobnicator );
+      }
+
+#if defined( __cpp_exceptions )
+      [[noreturn]] void raise( const ParseInput& in ) const
+      {
+         throw parse_error( message(), position( in ) );
+      }
+#endif
+   };
+
+   namespace internal
+   {
+      template< typename... States >
+      [[nodiscard]] decltype( auto ) last_state( States&&... st ) noexcept
+      {
+         return std::get< sizeof...( st ) - 1 >( std::tie( st... ) );
+      }
+
+      // Calls to raise() record the error in the error_result that is passed as last state
+      // instead of throwing an exception. Once an error was recorded every rule for which
+      // the control is enabled fails, and no more actions are applied, until the parse is
+      // back at the top, i.e. the error is propagated without unwinding.
+
+      template< template< typename... > class Control >
+      struct make_error_control
+      {
+         template< typename Rule >
+         struct type
+            : remove_last_state< Control< Rule > >
+         {
+            using base_t = remove_last_state< Control< Rule > >;
+
+            template< typename ParseInput, typename... States >
+            static void success( const ParseInput& in, States&&... st )
+            {
+               if( last_state( st... ) ) {
+                  base_t::failure( in, st... );
+               }
+               else {
+                  base_t::success( in, st... );
+               }
+            }
+
+            template< typename ParseInput, typename... States >
+            static void raise( const ParseInput& in, States&&... st )
+            {
+               if constexpr( sizeof...( st ) == 0 ) {
+                  Control< Rule >::raise( in );
+               }
+               else {
+                  auto& error = last_state( st... );
+                  if( !error ) {
+                     error.template set< Rule >( in );
+                  }
+               }
+            }
+
+            template< template< typename... > class Action, typename Frobnicator, typename ParseInput, typename... States >
+            static auto apply( const Frobnicator& begin, const ParseInput& in, States&&... st )
+               -> decltype( base_t::template apply< Action >( begin, in, st... ) )
+            {
+               using result_t = decltype( base_t::template apply< Action >( begin, in, st... ) );
+               if( last_state( st... ) ) {
+                  return result_t( false );
+               }
+               return base_t::template apply< Action >( begin, in, st... );
+            }
+
+            template< template< typename... > class Action, typename ParseInput, typename... States >
+            static auto apply0( const ParseInput& in, States&&... st )
+               -> decltype( base_t::template apply0< Action >( in, st... ) )
+            {
+               using result_t = decltype( base_t::template apply0< Action >( in, st... ) );
+               if( last_state( st... ) ) {
+                  return result_t( false );
+               }
+               return base_t::template apply0< Action >( in, st... );
+            }
+
+            template< apply_mode A,
+                      rewind_mode M,
+                      template< typename... >
+                      class Action,
+                      template< typename... >
+                      class Control2,
+                      typename ParseInput,
+                      typename... States >
+            [[nodiscard]] static bool match( ParseInput& in, States&&... st )
+            {
+               const auto& error = last_state( st... );
+               return ( !error ) && base_t::template match< A, M, Action, Control2 >( in, st... ) && ( !error );
+            }
+         };
+      };
+
+   }  // namespace internal
+
+   // Like parse(), but a global error is returned in 'error' instead of being thrown.
+   // Rules that catch exceptions, like try_catch, do not see these errors.
+
+   template< typename Rule,
+             template< typename... > class Action = nothing,
+             template< typename... > class Control = normal,
+             apply_mode A = apply_mode::action,
+             rewind_mode M = rewind_mode::dontcare,
+             typename ParseInput,
+             typename... States >
+   [[nodiscard]] bool parse_error_result( ParseInput&& in, error_result< std::decay_t< ParseInput > >& error, States&&... st )
+   {
+      return parse< Rule, Action, internal::make_error_control< Control >::template type, A, M >( in, st..., error );
+   }
+
+}  // namespace tao::pegtl
+
+#endif
@@ -0,0 +1,416 @@
+// Copyright (c) 2023 Dr. Colin Hirsch and Daniel Frey
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef TAO_PEGTL_CONTRIB_FLAT_PARSE_TREE_HPP
+#define TAO_PEGTL_CONTRIB_FLAT_PARSE_TREE_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined( __cpp_exceptions )
+#include <stdexcept>
+#else
+#include <cstdio>
+#include <exception>
+#endif
+
+#include "parse_tree.hpp"
+#include "remove_first_state.hpp"
+#include "shuffle_states.hpp"
+
+#include "../memory_input.hpp"
+#include "../normal.hpp"
+#include "../nothing.hpp"
+#include "../parse.hpp"
+#include "../position.hpp"
+#include "../visit.hpp"
+
+namespace tao::pegtl::parse_tree
+{
+   // All nodes of a flat tree are stored in a single vector, the root node first; the
+   // children of a node are linked via indices, the rule is given by its rule_id, and
+   // the content is given by offsets from the position at which parsing started.
+
+   template< typename Grammar >
+   class flat_tree
+   {
+   public:
+      using rules_t = rule_list_t< Grammar >;
+
+      static constexpr std::uint32_t npos = std::uint32_t( -1 );
+      static constexpr std::uint16_t root_rule = std::uint16_t( -1 );
+
+      static_assert( rules_t::size < root_rule, "too many rules for a flat tree" );
+
+      struct node
+      {
+         std::uint32_t first_child = npos;
+         std::uint32_t next_sibling = npos;
+         std::uint32_t begin = 0;
+         std::uint32_t end = npos;
+         std::uint16_t rule = root_rule;
+      };
+
+      template< typename Rule >
+      static constexpr std::uint16_t rule_id = std::uint16_t( rule_id_v< Grammar, Rule > );
+
+      std::vector< node > nodes;
+      const char* data = nullptr;
+      tao::pegtl::position start;
+      char eol;
+
+      flat_tree( const char* in_data, tao::pegtl::position in_start, const char in_eol )
+         : nodes( 1 ),
+           data( in_data ),
+           start( std::move( in_start ) ),
+           eol( in_eol )
+      {}
+
+      [[nodiscard]] const node& root() const noexcept
+      {
+         return nodes.front();
+      }
+
+      [[nodiscard]] const node& operator[]( const std::uint32_t index ) const noexcept
+      {
+         assert( index < nodes.size() );
+         return nodes[ index ];
+      }
+
+      [[nodiscard]] bool is_root( const node& n ) const noexcept
+      {
+         return n.rule == root_rule;
+      }
+
+      template< typename U >
+      [[nodiscard]] bool is_type( const node& n ) const noexcept
+      {
+         return n.rule == rule_id< U >;
+      }
+
+      [[nodiscard]] std::string_view type( const node& n ) const noexcept
+      {
+         return is_root( n ) ? std::string_view() : rule_name< Grammar >( n.rule );
+      }
+
+      [[nodiscard]] bool has_content( const node& n ) const noexcept
+      {
+         return n.end != npos;
+      }
+
+      [[nodiscard]] std::string_view string_view( const node& n ) const noexcept
+      {
+         assert( has_content( n ) );
+         return std::string_view( data + n.begin, n.end - n.begin );
+      }
+
+      [[nodiscard]] std::string string( const node& n ) const
+      {
+         return std::string( string_view( n ) );
+      }
+
+      // Lines and columns are not stored, they are counted from the start when a position is requested.
+
+      [[nodiscard]] tao::pegtl::position position( const std::uint32_t offset ) const
+      {
+         const char* const end = data + offset;
+         const auto lines = std::size_t( std::count( data, end, eol ) );
+         if( lines == 0 ) {
+            return tao::pegtl::position( start.byte + offset, start.line, start.column + offset, start.source );
+         }
+         const char* const bol = std::find( std::reverse_iterator< const char* >( end ), std::reverse_iterator< const char* >( data ), eol ).base();
+         return tao::pegtl::position( start.byte + offset, start.line + lines, std::size_t( end - bol ) + 1, start.source );
+      }
+
+      [[nodiscard]] tao::pegtl::position begin( const node& n ) const
+      {
+         return position( n.begin );
+      }
+
+      [[nodiscard]] tao::pegtl::position end( const node& n ) const
+      {
+         assert( has_content( n ) );
+         return position( n.end );
+      }
+   };
+
+   namespace internal
+   {
+      template< typename Selector, typename = void >
+      inline constexpr bool has_node_transform = false;
+
+      template< typename Selector >
+      inline constexpr bool has_node_transform< Selector, decltype( (void)Selector::transform( std::declval< std::unique_ptr< node >& >() ) ) > = true;
+
+      template< typename Selector, typename = void >
+      inline constexpr bool has_input_node_transform = false;
+
+      template< typename Selector >
+      inline constexpr bool has_input_node_transform< Selector, decltype( (void)Selector::transform( std::declval< const memory_input<>& >(), std::declval< std::unique_ptr< node >& >() ) ) > = true;
+
+      template< typename Grammar >
+      struct flat_state
+      {
+         using tree_t = flat_tree< Grammar >;
+         using node_t = typename tree_t::node;
+
+         static constexpr std::uint32_t npos = tree_t::npos;
+
+         // An open node, or a mark to undo the nodes added by an unselected rule on failure.
+
+         struct entry
+         {
+            std::uint32_t index;
+            std::uint32_t last_child;
+         };
+
+         tree_t tree;
+         std::vector< entry > open;
+         std::vector< entry > marks;
+
+         flat_state( const char* in_data, tao::pegtl::position in_start, const char in_eol )
+            : tree( in_data, std::move( in_start ), in_eol ),
+              open( 1, entry{ 0, npos } )
+         {}
+
+         template< typename ParseInput >
+         [[nodiscard]] std::uint32_t offset( const ParseInput& in ) const noexcept
+         {
+            return std::uint32_t( in.current() - tree.data );
+         }
+
+         [[nodiscard]] std::uint32_t size() const noexcept
+         {
+            return std::uint32_t( tree.nodes.size() );
+         }
+
+         void truncate( const std::uint32_t index ) noexcept
+         {
+            tree.nodes.erase( tree.nodes.begin() + index, tree.nodes.end() );
+         }
+
+         // Replaces the node at index, which must be the last open node, by its only child.
+
+         void fold( const std::uint32_t index ) noexcept
+         {
+            assert( tree.nodes[ index ].first_child == index + 1 );
+            assert( tree.nodes[ index + 1 ].next_sibling == npos );
+            tree.nodes.erase( tree.nodes.begin() + index );
+            for( auto i = tree.nodes.begin() + index; i != tree.nodes.end(); ++i ) {
+               i->first_child -= ( i->first_child != npos );
+               i->next_sibling -= ( i->next_sibling != npos );
+            }
+         }
+
+         void link( const std::uint32_t child ) noexcept
+         {
+            entry& parent = open.back();
+            if( parent.last_child == npos ) {
+               tree.nodes[ parent.index ].first_child = child;
+            }
+            else {
+               tree.nodes[ parent.last_child ].next_sibling = child;
+            }
+            parent.last_child = child;
+         }
+
+         void mark()
+         {
+            marks.push_back( entry{ size(), open.back().last_child } );
+         }
+
+         void unmark() noexcept
+         {
+            marks.pop_back();
+         }
+
+         void restore() noexcept
+         {
+            const entry m = marks.back();
+            marks.pop_back();
+            entry& parent = open.back();
+            if( m.last_child == npos ) {
+               tree.nodes[ parent.index ].first_child = npos;
+            }
+            else {
+               tree.nodes[ m.last_child ].next_sibling = npos;
+            }
+            parent.last_child = m.last_child;
+            truncate( m.index );
+         }
+
+         template< typename Rule, typename ParseInput >
+         void start( const ParseInput& in )
+         {
+            open.push_back( entry{ size(), npos } );
+            tree.nodes.push_back( node_t{ npos, npos, offset( in ), npos, tree_t::template rule_id< Rule > } );
+         }
+
+         // The transformers included with the parse tree are applied natively.
+
+         template< typename Selector, typename ParseInput >
+         void success( const ParseInput& in ) noexcept
+         {
+            const entry e = open.back();
+            open.pop_back();
+            node_t& n = tree.nodes[ e.index ];
+            n.end = offset( in );
+            if constexpr( std::is_base_of_v< fold_one, Selector > ) {
+               if( ( n.first_child != npos ) && ( tree.nodes[ n.first_child ].next_sibling == npos ) ) {
+                  fold( e.index );
+                  link( e.index );
+                  return;
+               }
+               n.end = npos;
+            }
+            else if constexpr( std::is_base_of_v< discard_empty, Selector > ) {
+               if( n.first_child == npos ) {
+                  truncate( e.index );
+                  return;
+               }
+               n.end = npos;
+            }
+            else if constexpr( std::is_base_of_v< remove_content, Selector > ) {
+               n.end = npos;
+            }
+            else {
+               static_assert( std::is_base_of_v< store_content, Selector > || !( has_node_transform< Selector > || has_input_node_transform< Selector > ), "custom transformers are not supported by flat trees" );
+            }
+            link( e.index );
+         }
+
+         void failure() noexcept
+         {
+            truncate( open.back().index );
+            open.pop_back();
+         }
+      };
+
+      template< typename Grammar, template< typename... > class Selector, template< typename... > class Control >
+      struct make_flat_control
+      {
+         template< typename Rule, bool, bool >
+         struct state_handler;
+
+         template< typename Rule >
+         using type = rotate_states_right< state_handler< Rule, is_selected_node< Rule, Selector >, is_leaf< 8, typename Rule::subs_t, Selector > > >;
+      };
+
+      template< typename Grammar, template< typename... > class Selector, template< typename... > class Control >
+      template< typename Rule >
+      struct make_flat_control< Grammar, Selector, Control >::state_handler< Rule, false, true >
+         : remove_first_state< Control< Rule > >
+      {};
+
+      template< typename Grammar, template< typename... > class Selector, template< typename... > class Control >
+      template< typename Rule >
+      struct make_flat_control< Grammar, Selector, Control >::state_handler< Rule, false, false >
+         : remove_first_state< Control< Rule > >
+      {
+         static constexpr bool enable = true;
+
+         template< typename ParseInput, typename... States >
+         static void start( const ParseInput& /*unused*/, flat_state< Grammar >& state, States&&... /*unused*/ )
+         {
+            state.mark();
+         }
+
+         template< typename ParseInput, typename... States >
+         static void success( const ParseInput& /*unused*/, flat_state< Grammar >& state, States&&... /*unused*/ )
+         {
+            state.unmark();
+         }
+
+         template< typename ParseInput, typename... States >
+         static void failure( const ParseInput& /*unused*/, flat_state< Grammar >& state, States&&... /*unused*/ )
+         {
+            state.restore();
+         }
+
+         template< typename ParseInput, typename... States >
+         static void unwind( const ParseInput& /*unused*/, flat_state< Grammar >& state, States&&... /*unused*/ )
+         {
+            state.restore();
+         }
+      };
+
+      template< typename Grammar, template< typename... > class Selector, template< typename... > class Control >
+      template< typename Rule, bool B >
+      struct make_flat_control< Grammar, Selector, Control >::state_handler< Rule, true, B >
+         : remove_first_state< Control< Rule > >
+      {
+         template< typename ParseInput, typename... States >
+         static void start( const ParseInput& in, flat_state< Grammar >& state, States&&... st )
+         {
+            Control< Rule >::start( in, st... );
+            state.template start< Rule >( in );
+         }
+
+         template< typename ParseInput, typename... States >
+         static void success( const ParseInput& in, flat_state< Grammar >& state, States&&... st )
+         {
+            state.template success< Selector< Rule > >( in );
+            Control< Rule >::success( in, st... );
+         }
+
+         template< typename ParseInput, typename... States >
+         static void failure( const ParseInput& in, flat_state< Grammar >& state, States&&... st )
+         {
+            state.failure();
+            Control< Rule >::failure( in, st... );
+         }
+
+         template< typename ParseInput, typename... States >
+         static void unwind( [[maybe_unused]] const ParseInput& in, flat_state< Grammar >& state, States&&... st )
+         {
+            state.failure();
+            if constexpr( control_has_unwind< Control< Rule >, const ParseInput&, States... > ) {
+               Control< Rule >::unwind( in, st... );
+            }
+#if defined( _MSC_VER )
+            ( (void)st,
+              ... );
+#endif
+         }
+      };
+
+   }  // namespace internal
+
+   template< typename Rule,
+             template< typename... > class Selector = internal::store_all,
+             template< typename... > class Action = nothing,
+             template< typename... > class Control = normal,
+             typename ParseInput,
+             typename... States >
+   [[nodiscard]] std::optional< flat_tree< Rule > > parse_flat( ParseInput&& in, States&&... st )
+   {
+      if( std::size_t( in.end() - in.current() ) >= flat_tree< Rule >::npos ) {
+#if defined( __cpp_exceptions )
+         throw std::length_error( "input too large for flat parse tree" );
+#else
+         std::fputs( "length error: input too large for flat parse tree\n", stderr );
+         std::terminate();
+#endif
+      }
+      internal::flat_state< Rule > state( in.current(), in.position(), std::decay_t< ParseInput >::eol_t::ch );
+      if( !tao::pegtl::parse< Rule, Action, internal::make_flat_control< Rule, Selector, Control >::template type >( in, st..., state ) ) {
+         return std::nullopt;
+      }
+      assert( state.open.size() == 1 );
+      assert( state.marks.empty() );
+      return std::move( state.tree );
+   }
+
+}  // namespace tao::pegtl::parse_tree
+
+#endif
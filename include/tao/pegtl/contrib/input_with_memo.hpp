@@ -0,0 +1,101 @@
+// Copyright (c) 2023 Dr. Colin Hirsch and Daniel Frey
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef TAO_PEGTL_CONTRIB_INPUT_WITH_MEMO_HPP
+#define TAO_PEGTL_CONTRIB_INPUT_WITH_MEMO_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../apply_mode.hpp"
+
+namespace tao::pegtl
+{
+   namespace internal
+   {
+      // The address of memo_key< Rule, A > serves as unique identifier for the
+      // rule and the apply mode, results are never shared between apply modes.
+
+      template< typename Rule, apply_mode A >
+      inline constexpr char memo_key = 0;
+
+      template< typename Data >
+      struct memo_entry
+      {
+         const void* key = nullptr;
+         std::size_t byte = 0;
+         std::size_t generation = 0;
+         bool success = false;
+         Data end{};
+      };
+
+   }  // namespace internal
+
+   // The memo table is a direct-mapped cache with a fixed number of
+   // entries that is allocated once per input; colliding entries are
+   // simply overwritten, which keeps the memory usage bounded. Since
+   // the entries point into the input data the table is cleared when
+   // the input discards data, e.g. after a cut; clearing is O(1).
+
+   template< typename Input, std::size_t Entries = 4096 >
+   class input_with_memo
+      : public Input
+   {
+   public:
+      static_assert( ( Entries != 0 ) && ( ( Entries & ( Entries - 1 ) ) == 0 ), "number of memo entries must be a power of two" );
+
+      using memo_entry_t = internal::memo_entry< std::decay_t< decltype( std::declval< Input& >().rewind_save() ) > >;
+
+      using Input::Input;
+
+      template< typename Rule, apply_mode A >
+      [[nodiscard]] const memo_entry_t* memo_find() const noexcept
+      {
+         const void* key = &internal::memo_key< Rule, A >;
+         const std::size_t byte = this->byte();
+         const auto& e = m_memo[ memo_index( key, byte ) ];
+         return ( ( e.key == key ) && ( e.byte == byte ) && ( e.generation == m_generation ) ) ? &e : nullptr;
+      }
+
+      template< typename Rule, apply_mode A >
+      void memo_insert( const std::size_t byte, const bool success ) noexcept
+      {
+         const void* key = &internal::memo_key< Rule, A >;
+         auto& e = m_memo[ memo_index( key, byte ) ];
+         e.key = key;
+         e.byte = byte;
+         e.generation = m_generation;
+         e.success = success;
+         if( success ) {
+            e.end = this->rewind_save();
+         }
+      }
+
+      void memo_clear() noexcept
+      {
+         ++m_generation;
+      }
+
+      void discard() noexcept
+      {
+         Input::discard();
+         memo_clear();
+      }
+
+   private:
+      [[nodiscard]] static std::size_t memo_index( const void* key, const std::size_t byte ) noexcept
+      {
+         return ( byte * 0x9e3779b1U + ( reinterpret_cast< std::uintptr_t >( key ) >> 3 ) ) & ( Entries - 1 );
+      }
+
+      std::vector< memo_entry_t > m_memo = std::vector< memo_entry_t >( Entries );
+      std::size_t m_generation = 1;
+   };
+
+}  // namespace tao::pegtl
+
+#endif
@@ -80,7 +80,7 @@ namespace tao::pegtl::json
       using content = object_content;
    };
 
-   struct value : sor< string, number, object, array, false_, true_, null > {};
+   struct value : sor_dispatch< string, number, object, array, false_, true_, null > {};
    struct array_element : padr< value > {};
 
    struct text : pad< value, ws > {};
@@ -0,0 +1,81 @@
+// Copyright (c) 2023 Dr. Colin Hirsch and Daniel Frey
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef TAO_PEGTL_CONTRIB_MEMOIZE_HPP
+#define TAO_PEGTL_CONTRIB_MEMOIZE_HPP
+
+#include <type_traits>
+
+#include "../apply_mode.hpp"
+#include "../match.hpp"
+#include "../nothing.hpp"
+#include "../rewind_mode.hpp"
+#include "../type_list.hpp"
+#include "../visit.hpp"
+
+#include "../internal/has_apply.hpp"
+#include "../internal/has_apply0.hpp"
+
+namespace tao::pegtl
+{
+   struct memoize;
+
+   namespace internal
+   {
+      template< typename Rule, template< typename... > class Action, template< typename... > class Control, typename ParseInput, typename... States >
+      inline constexpr bool memo_has_apply = has_apply< Control< Rule >, void, Action, const typename ParseInput::frobnicator_t&, const ParseInput&, States... > || has_apply< Control< Rule >, bool, Action, const typename ParseInput::frobnicator_t&, const ParseInput&, States... > || has_apply0< Control< Rule >, void, Action, const ParseInput&, States... > || has_apply0< Control< Rule >, bool, Action, const ParseInput&, States... >;
+
+      template< typename Rule, template< typename... > class Action, template< typename... > class Control, typename ParseInput, typename... States >
+      inline constexpr bool memo_without_action = ( !Control< Rule >::enable ) || std::is_base_of_v< nothing< Rule >, Action< Rule > > || ( std::is_base_of_v< memoize, Action< Rule > > && !memo_has_apply< Rule, Action, Control, ParseInput, States... > );
+
+      template< typename Rules, template< typename... > class Action, template< typename... > class Control, typename ParseInput, typename... States >
+      inline constexpr bool memo_without_actions = false;
+
+      template< typename... Rules, template< typename... > class Action, template< typename... > class Control, typename ParseInput, typename... States >
+      inline constexpr bool memo_without_actions< type_list< Rules... >, Action, Control, ParseInput, States... > = ( memo_without_action< Rules, Action, Control, ParseInput, States... > && ... );
+
+   }  // namespace internal
+
+   // Packrat-style memoization for selected rules, requires an input_with_memo<>.
+   // Results are remembered separately for each apply mode. Failures are always
+   // replayed; successes are replayed when actions are disabled, or when neither
+   // the rule nor any of its sub-rules has an action other than memoize, so that
+   // no action is ever skipped. Control callbacks are not called for replayed
+   // matches.
+
+   struct memoize
+      : maybe_nothing
+   {
+      template< typename Rule,
+                apply_mode A,
+                rewind_mode M,
+                template< typename... >
+                class Action,
+                template< typename... >
+                class Control,
+                typename ParseInput,
+                typename... States >
+      [[nodiscard]] static bool match( ParseInput& in, States&&... st )
+      {
+         constexpr bool replay = ( A == apply_mode::nothing ) || internal::memo_without_actions< rule_list_t< Rule >, Action, Control, ParseInput, States... >;
+
+         if( const auto* e = in.template memo_find< Rule, A >() ) {
+            if( !e->success ) {
+               return false;
+            }
+            if constexpr( replay ) {
+               in.rewind_restore( e->end );
+               return true;
+            }
+         }
+         const auto byte = in.byte();
+         const bool result = tao::pegtl::match< Rule, A, M, Action, Control >( in, st... );
+         in.template memo_insert< Rule, A >( byte, result );
+         return result;
+      }
+   };
+
+}  // namespace tao::pegtl
+
+#endif
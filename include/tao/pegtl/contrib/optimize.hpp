@@ -0,0 +1,330 @@
+// Copyright (c) 2023 Dr. Colin Hirsch and Daniel Frey
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef TAO_PEGTL_CONTRIB_OPTIMIZE_HPP
+#define TAO_PEGTL_CONTRIB_OPTIMIZE_HPP
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include "../ascii.hpp"
+#include "../nothing.hpp"
+#include "../rules.hpp"
+#include "../type_list.hpp"
+
+namespace tao::pegtl
+{
+   namespace internal
+   {
+      // The rewrites only apply to the anonymous rule templates that are matched exactly,
+      // any other rule, in particular every rule that is a user-defined struct, is left
+      // untouched and remains visible to actions and the control class under its name.
+      // Anonymous rules with an action are also left untouched, and they are neither
+      // spliced, fused nor merged into their parent.
+
+      template< typename Rule, template< typename... > class Action >
+      inline constexpr bool optimize_has_action = !std::is_base_of_v< nothing< Rule >, Action< Rule > >;
+
+      template< typename Rule, template< typename... > class Action, bool = optimize_has_action< Rule, Action > >
+      struct optimize_rule
+      {
+         using type = Rule;
+      };
+
+      template< typename Rule, template< typename... > class Action >
+      using optimize_rule_t = typename optimize_rule< Rule, Action >::type;
+
+      // Literal rule types that adjacent sub-rules of a seq are fused into.
+
+      template< typename Rule, template< typename... > class Action, bool = optimize_has_action< Rule, Action > >
+      struct optimize_literal
+      {
+         using type = void;
+      };
+
+      template< char C, template< typename... > class Action >
+      struct optimize_literal< ascii::one< C >, Action, false >
+      {
+         using type = ascii::string< C >;
+      };
+
+      template< char... Cs, template< typename... > class Action >
+      struct optimize_literal< ascii::string< Cs... >, Action, false >
+      {
+         using type = ascii::string< Cs... >;
+      };
+
+      template< char... Cs, template< typename... > class Action >
+      struct optimize_literal< ascii::istring< Cs... >, Action, false >
+      {
+         using type = ascii::istring< Cs... >;
+      };
+
+      template< typename Rule, template< typename... > class Action >
+      using optimize_literal_t = typename optimize_literal< Rule, Action >::type;
+
+      template< typename L, typename R >
+      struct optimize_fuse
+      {
+         using type = void;
+      };
+
+      template< char... Ls, char... Rs >
+      struct optimize_fuse< ascii::string< Ls... >, ascii::string< Rs... > >
+      {
+         using type = ascii::string< Ls..., Rs... >;
+      };
+
+      template< char... Ls, char... Rs >
+      struct optimize_fuse< ascii::istring< Ls... >, ascii::istring< Rs... > >
+      {
+         using type = ascii::istring< Ls..., Rs... >;
+      };
+
+      // Prepends Rule to the already fused List, fusing it with the first element when possible.
+
+      template< typename Fused, typename Rule, typename Head, typename... Rules >
+      struct optimize_seq_join
+      {
+         using type = type_list< Fused, Rules... >;
+      };
+
+      template< typename Rule, typename Head, typename... Rules >
+      struct optimize_seq_join< void, Rule, Head, Rules... >
+      {
+         using type = type_list< Rule, Head, Rules... >;
+      };
+
+      template< typename Rule, typename List, template< typename... > class Action >
+      struct optimize_seq_cons;
+
+      template< typename Rule, template< typename... > class Action >
+      struct optimize_seq_cons< Rule, empty_list, Action >
+      {
+         using type = type_list< Rule >;
+      };
+
+      template< typename Rule, typename Head, typename... Rules, template< typename... > class Action >
+      struct optimize_seq_cons< Rule, type_list< Head, Rules... >, Action >
+         : optimize_seq_join< typename optimize_fuse< optimize_literal_t< Rule, Action >, optimize_literal_t< Head, Action > >::type, Rule, Head, Rules... >
+      {};
+
+      template< typename List, template< typename... > class Action >
+      struct optimize_seq_fuse;
+
+      template< template< typename... > class Action >
+      struct optimize_seq_fuse< empty_list, Action >
+      {
+         using type = empty_list;
+      };
+
+      template< typename Rule, typename... Rules, template< typename... > class Action >
+      struct optimize_seq_fuse< type_list< Rule, Rules... >, Action >
+         : optimize_seq_cons< Rule, typename optimize_seq_fuse< type_list< Rules... >, Action >::type, Action >
+      {};
+
+      // Prepends Rule to the already merged List, merging adjacent one<> rules of a sor.
+
+      template< typename Rule, typename List, template< typename... > class Action, typename = void >
+      struct optimize_sor_cons
+      {
+         using type = type_list_concat_t< type_list< Rule >, List >;
+      };
+
+      template< char... Ls, char... Rs, typename... Rules, template< typename... > class Action >
+      struct optimize_sor_cons< ascii::one< Ls... >, type_list< ascii::one< Rs... >, Rules... >, Action, std::enable_if_t< !optimize_has_action< ascii::one< Ls... >, Action > && !optimize_has_action< ascii::one< Rs... >, Action > > >
+      {
+         using type = type_list< ascii::one< Ls..., Rs... >, Rules... >;
+      };
+
+      template< typename List, template< typename... > class Action >
+      struct optimize_sor_merge;
+
+      template< template< typename... > class Action >
+      struct optimize_sor_merge< empty_list, Action >
+      {
+         using type = empty_list;
+      };
+
+      template< typename Rule, typename... Rules, template< typename... > class Action >
+      struct optimize_sor_merge< type_list< Rule, Rules... >, Action >
+         : optimize_sor_cons< Rule, typename optimize_sor_merge< type_list< Rules... >, Action >::type, Action >
+      {};
+
+      // Nested seq and sor rules are spliced into their parent of the same kind.
+
+      template< template< typename... > class Outer, typename Rule, template< typename... > class Action, bool = optimize_has_action< Rule, Action > >
+      struct optimize_splice
+      {
+         using type = type_list< Rule >;
+      };
+
+      template< template< typename... > class Outer, typename... Rules, template< typename... > class Action >
+      struct optimize_splice< Outer, Outer< Rules... >, Action, false >
+      {
+         using type = type_list< Rules... >;
+      };
+
+      template< template< typename... > class Outer, typename List >
+      struct optimize_single;
+
+      template< template< typename... > class Outer, typename... Rules >
+      struct optimize_single< Outer, type_list< Rules... > >
+      {
+         using type = Outer< Rules... >;
+      };
+
+      template< template< typename... > class Outer, typename Rule >
+      struct optimize_single< Outer, type_list< Rule > >
+      {
+         using type = Rule;
+      };
+
+      template< typename... Rules, template< typename... > class Action >
+      struct optimize_rule< pegtl::seq< Rules... >, Action, false >
+         : optimize_single< pegtl::seq, typename optimize_seq_fuse< type_list_concat_t< typename optimize_splice< pegtl::seq, optimize_rule_t< Rules, Action >, Action >::type... >, Action >::type >
+      {};
+
+      template< typename... Rules, template< typename... > class Action >
+      struct optimize_rule< pegtl::sor< Rules... >, Action, false >
+         : optimize_single< pegtl::sor, typename optimize_sor_merge< type_list_concat_t< typename optimize_splice< pegtl::sor, optimize_rule_t< Rules, Action >, Action >::type... >, Action >::type >
+      {};
+
+      // An opt of a rule that can succeed without consuming input is redundant.
+
+      template< typename Rule, template< typename... > class Action, bool = optimize_has_action< Rule, Action > >
+      struct optimize_opt
+      {
+         using type = pegtl::opt< Rule >;
+      };
+
+      template< typename... Rules, template< typename... > class Action >
+      struct optimize_opt< pegtl::opt< Rules... >, Action, false >
+      {
+         using type = pegtl::opt< Rules... >;
+      };
+
+      template< typename Rule, typename... Rules, template< typename... > class Action >
+      struct optimize_opt< pegtl::star< Rule, Rules... >, Action, false >
+      {
+         using type = pegtl::star< Rule, Rules... >;
+      };
+
+      template< typename Rule, typename... Rules, template< typename... > class Action >
+      struct optimize_opt< pegtl::plus< Rule, Rules... >, Action, false >
+      {
+         using type = pegtl::star< Rule, Rules... >;
+      };
+
+      template< typename... Rules, template< typename... > class Action >
+      struct optimize_rule< pegtl::opt< Rules... >, Action, false >
+      {
+         using type = pegtl::opt< optimize_rule_t< Rules, Action >... >;
+      };
+
+      template< typename Rule, template< typename... > class Action >
+      struct optimize_rule< pegtl::opt< Rule >, Action, false >
+         : optimize_opt< optimize_rule_t< Rule, Action >, Action >
+      {};
+
+      // A rep of a literal becomes a single longer literal; the limit keeps the compare short.
+
+      inline constexpr std::size_t optimize_rep_limit = 64;
+
+      template< typename String, typename Indices >
+      struct optimize_rep_string;
+
+      template< char... Cs, std::size_t... Is >
+      struct optimize_rep_string< ascii::string< Cs... >, std::index_sequence< Is... > >
+      {
+         static constexpr char chars[] = { Cs... };
+         using type = ascii::string< chars[ Is % sizeof...( Cs ) ]... >;
+      };
+
+      template< unsigned Num, typename Rule, template< typename... > class Action, typename = void >
+      struct optimize_rep
+      {
+         using type = pegtl::rep< Num, Rule >;
+      };
+
+      template< unsigned Num, char... Cs, template< typename... > class Action >
+      struct optimize_rep< Num, ascii::string< Cs... >, Action, std::enable_if_t< ( sizeof...( Cs ) > 0 ) && ( Num * sizeof...( Cs ) <= optimize_rep_limit ) && !optimize_has_action< ascii::string< Cs... >, Action > > >
+         : optimize_rep_string< ascii::string< Cs... >, std::make_index_sequence< Num * sizeof...( Cs ) > >
+      {};
+
+      template< unsigned Num, char C, template< typename... > class Action >
+      struct optimize_rep< Num, ascii::one< C >, Action, std::enable_if_t< ( Num <= optimize_rep_limit ) && !optimize_has_action< ascii::one< C >, Action > > >
+         : optimize_rep_string< ascii::string< C >, std::make_index_sequence< Num > >
+      {};
+
+      template< unsigned Num, typename... Rules, template< typename... > class Action >
+      struct optimize_rule< pegtl::rep< Num, Rules... >, Action, false >
+      {
+         using type = pegtl::rep< Num, optimize_rule_t< Rules, Action >... >;
+      };
+
+      template< unsigned Num, typename Rule, template< typename... > class Action >
+      struct optimize_rule< pegtl::rep< Num, Rule >, Action, false >
+         : optimize_rep< Num, optimize_rule_t< Rule, Action >, Action >
+      {};
+
+      // The remaining combinators are rebuilt with their optimised sub-rules.
+
+      template< typename... Rules, template< typename... > class Action >
+      struct optimize_rule< pegtl::at< Rules... >, Action, false >
+      {
+         using type = pegtl::at< optimize_rule_t< Rules, Action >... >;
+      };
+
+      template< typename... Rules, template< typename... > class Action >
+      struct optimize_rule< pegtl::not_at< Rules... >, Action, false >
+      {
+         using type = pegtl::not_at< optimize_rule_t< Rules, Action >... >;
+      };
+
+      template< typename Rule, typename... Rules, template< typename... > class Action >
+      struct optimize_rule< pegtl::plus< Rule, Rules... >, Action, false >
+      {
+         using type = pegtl::plus< optimize_rule_t< Rule, Action >, optimize_rule_t< Rules, Action >... >;
+      };
+
+      template< typename Rule, typename... Rules, template< typename... > class Action >
+      struct optimize_rule< pegtl::star< Rule, Rules... >, Action, false >
+      {
+         using type = pegtl::star< optimize_rule_t< Rule, Action >, optimize_rule_t< Rules, Action >... >;
+      };
+
+      template< unsigned Min, typename Rule, typename... Rules, template< typename... > class Action >
+      struct optimize_rule< pegtl::rep_min< Min, Rule, Rules... >, Action, false >
+      {
+         using type = pegtl::rep_min< Min, optimize_rule_t< Rule, Action >, optimize_rule_t< Rules, Action >... >;
+      };
+
+      template< unsigned Max, typename... Rules, template< typename... > class Action >
+      struct optimize_rule< pegtl::rep_max< Max, Rules... >, Action, false >
+      {
+         using type = pegtl::rep_max< Max, optimize_rule_t< Rules, Action >... >;
+      };
+
+      template< unsigned Min, unsigned Max, typename... Rules, template< typename... > class Action >
+      struct optimize_rule< pegtl::rep_min_max< Min, Max, Rules... >, Action, false >
+      {
+         using type = pegtl::rep_min_max< Min, Max, optimize_rule_t< Rules, Action >... >;
+      };
+
+      template< unsigned Max, typename... Rules, template< typename... > class Action >
+      struct optimize_rule< pegtl::rep_opt< Max, Rules... >, Action, false >
+      {
+         using type = pegtl::rep_opt< Max, optimize_rule_t< Rules, Action >... >;
+      };
+
+   }  // namespace internal
+
+   template< typename Rule, template< typename... > class Action = nothing >
+   using optimize = internal::optimize_rule_t< Rule, Action >;
+
+}  // namespace tao::pegtl
+
+#endif
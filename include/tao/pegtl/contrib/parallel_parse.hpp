@@ -0,0 +1,167 @@
+// Copyright (c) 2023 Dr. Colin Hirsch and Daniel Frey
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef TAO_PEGTL_CONTRIB_PARALLEL_PARSE_HPP
+#define TAO_PEGTL_CONTRIB_PARALLEL_PARSE_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "../apply_mode.hpp"
+#include "../memory_input.hpp"
+#include "../normal.hpp"
+#include "../nothing.hpp"
+#include "../parse.hpp"
+#include "../rewind_mode.hpp"
+#include "../rules.hpp"
+#include "../tracking_mode.hpp"
+
+#include "../internal/bump.hpp"
+#include "../internal/frobnicator.hpp"
+
+namespace tao::pegtl
+{
+   namespace internal
+   {
+      // Returns the position after the first match of Separator at or after begin, or end if there is none.
+
+      template< typename Separator, typename Eol >
+      [[nodiscard]] const char* parallel_split( const char* begin, const char* end )
+      {
+         for( const char* p = begin; p < end; ++p ) {
+            memory_input< tracking_mode::lazy, Eol, const char* > in( p, end, "" );
+            if( normal< Separator >::template match< apply_mode::nothing, rewind_mode::dontcare, nothing, normal >( in ) ) {
+               return in.current();
+            }
+         }
+         return end;
+      }
+
+      // Calls f( i ) for all i in [0, count) on up to threads threads, including the calling one.
+
+      template< typename F >
+      void parallel_for( const std::size_t count, const std::size_t threads, const F& f )
+      {
+         std::atomic< std::size_t > next = 0;
+         const auto work = [ & ] {
+            for( std::size_t i = next++; i < count; i = next++ ) {
+               f( i );
+            }
+         };
+         std::vector< std::thread > pool;
+         for( std::size_t t = 1; t < ( std::min )( threads, count ); ++t ) {
+            pool.emplace_back( work );
+         }
+         work();
+         for( auto& t : pool ) {
+            t.join();
+         }
+      }
+
+   }  // namespace internal
+
+   // Splits the remaining input into chunks that end after a match of Separator,
+   // and parses each chunk as until< eof, Record > on its own thread with its own
+   // default-constructed State. The input of each chunk is a memory_input<> with
+   // the correct byte, line and column of the chunk's beginning. On success the
+   // chunk states are combined with reducer( state, std::move( chunk ) ), in the
+   // order of the chunks, and the input is advanced to its end. When a chunk fails
+   // to parse false is returned, when it throws the exception of the first such
+   // chunk is re-thrown; in both cases the state and the input are left unchanged.
+
+   template< typename Record,
+             typename Separator,
+             template< typename... > class Action = nothing,
+             template< typename... > class Control = normal,
+             typename ParseInput,
+             typename State,
+             typename Reducer >
+   bool parallel_parse( ParseInput& in,
+                        State& state,
+                        Reducer&& reducer,
+                        const std::size_t threads = ( std::max )( std::thread::hardware_concurrency(), 1U ),
+                        const std::size_t minimum = 64 * 1024 )
+   {
+      using eol_t = typename ParseInput::eol_t;
+      using input_t = memory_input< ParseInput::tracking_mode_v, eol_t, typename ParseInput::source_t >;
+
+      const char* const begin = in.current();
+      const char* const end = in.end();
+      const std::size_t size = static_cast< std::size_t >( end - begin );
+      const std::size_t count = ( std::max )( std::size_t( 1 ), ( std::min )( 4 * threads, size / ( std::max )( minimum, std::size_t( 1 ) ) ) );
+
+      std::vector< const char* > bounds( count + 1, end );
+      bounds[ 0 ] = begin;
+      for( std::size_t i = 1; i < count; ++i ) {
+         bounds[ i ] = internal::parallel_split< Separator, eol_t >( ( std::max )( bounds[ i - 1 ], begin + i * ( size / count ) ), end );
+      }
+      std::vector< internal::lines_and_last > lines( count );
+      internal::parallel_for( count, threads, [ & ]( const std::size_t i ) {
+         lines[ i ] = internal::scan_lines( bounds[ i ], static_cast< std::size_t >( bounds[ i + 1 ] - bounds[ i ] ), eol_t::ch );
+      } );
+      std::vector< internal::frobnicator > starts;
+      starts.reserve( count + 1 );
+      {
+         const auto p = in.position();
+         starts.emplace_back( begin, p.byte, p.line, p.column );
+      }
+      for( std::size_t i = 0; i < count; ++i ) {
+         internal::frobnicator f = starts.back();
+         const std::size_t n = static_cast< std::size_t >( bounds[ i + 1 ] - bounds[ i ] );
+         f.line += lines[ i ].lines;
+         f.column = ( lines[ i ].lines != 0 ) ? ( n - lines[ i ].last + 1 ) : ( f.column + n );
+         f.byte += n;
+         f.data += n;
+         starts.emplace_back( f );
+      }
+      std::vector< State > states( count );
+      std::vector< char > results( count, 0 );
+#if defined( __cpp_exceptions )
+      std::vector< std::exception_ptr > errors( count );
+#endif
+      internal::parallel_for( count, threads, [ & ]( const std::size_t i ) {
+         const auto& s = starts[ i ];
+#if defined( __cpp_exceptions )
+         try {
+            input_t chunk( s.data, bounds[ i + 1 ], in.source(), s.byte, s.line, s.column );
+            results[ i ] = pegtl::parse< until< eof, Record >, Action, Control >( chunk, states[ i ] );
+         }
+         catch( ... ) {
+            errors[ i ] = std::current_exception();
+         }
+#else
+         input_t chunk( s.data, bounds[ i + 1 ], in.source(), s.byte, s.line, s.column );
+         results[ i ] = pegtl::parse< until< eof, Record >, Action, Control >( chunk, states[ i ] );
+#endif
+      } );
+      for( std::size_t i = 0; i < count; ++i ) {
+#if defined( __cpp_exceptions )
+         if( errors[ i ] ) {
+            std::rethrow_exception( errors[ i ] );
+         }
+#endif
+         if( !results[ i ] ) {
+            return false;
+         }
+      }
+      for( auto& s : states ) {
+         reducer( state, std::move( s ) );
+      }
+      if constexpr( ParseInput::tracking_mode_v == tracking_mode::eager ) {
+         in.rewind_restore( starts.back() );
+      }
+      else {
+         in.rewind_restore( end );
+      }
+      return true;
+   }
+
+}  // namespace tao::pegtl
+
+#endif
@@ -0,0 +1,321 @@
+// Copyright (c) 2023 Dr. Colin Hirsch and Daniel Frey
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef TAO_PEGTL_CONTRIB_PARSE_EVENTS_HPP
+#define TAO_PEGTL_CONTRIB_PARSE_EVENTS_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include "parse_tree.hpp"
+#include "remove_first_state.hpp"
+#include "shuffle_states.hpp"
+
+#include "../apply_mode.hpp"
+#include "../normal.hpp"
+#include "../nothing.hpp"
+#include "../parse.hpp"
+#include "../rewind_mode.hpp"
+#include "../visit.hpp"
+
+#include "../internal/unwind_guard.hpp"
+
+namespace tao::pegtl::parse_tree
+{
+   // Selected rules that have selected sub-rules generate an enter event when they
+   // start and a leave event when they succeed, all other selected rules generate a
+   // token event when they succeed. The rule is given by its rule_id, the content by
+   // the byte offsets of the begin and the end, the latter equals begin for enter.
+
+   // Events are passed on immediately; when the parser backtracks over input for which
+   // events were already passed on, a rollback event is generated whose begin (and end)
+   // is the number of preceding events that remain valid, all later ones are retracted.
+   // Its rule is that of the rule whose failure led to the rollback.
+
+   enum class event_type : std::uint8_t
+   {
+      enter,
+      leave,
+      token,
+      rollback
+   };
+
+   struct event
+   {
+      std::size_t begin = 0;
+      std::size_t end = 0;
+      std::uint16_t rule = 0;
+      event_type type = event_type::token;
+   };
+
+   // Lock-free single-producer single-consumer queue of events that can be used as
+   // sink for parse_events(); the producer waits while the ring is full, and has to
+   // call close() when done, also when parse_events() throws an exception.
+
+   template< std::size_t Capacity = 4096 >
+   class event_ring
+   {
+   public:
+      static_assert( ( Capacity != 0 ) && ( ( Capacity & ( Capacity - 1 ) ) == 0 ), "event ring capacity must be a power of two" );
+
+      event_ring()
+         : m_events( new event[ Capacity ] )
+      {}
+
+      event_ring( const event_ring& ) = delete;
+      event_ring( event_ring&& ) = delete;
+
+      ~event_ring() = default;
+
+      event_ring& operator=( const event_ring& ) = delete;
+      event_ring& operator=( event_ring&& ) = delete;
+
+      void operator()( const event& e ) noexcept
+      {
+         const std::size_t tail = m_tail.load( std::memory_order_relaxed );
+         while( tail - m_head.load( std::memory_order_acquire ) == Capacity ) {
+            std::this_thread::yield();
+         }
+         m_events[ tail & ( Capacity - 1 ) ] = e;
+         m_tail.store( tail + 1, std::memory_order_release );
+      }
+
+      void close() noexcept
+      {
+         m_closed.store( true, std::memory_order_release );
+      }
+
+      [[nodiscard]] bool try_pop( event& e ) noexcept
+      {
+         const std::size_t head = m_head.load( std::memory_order_relaxed );
+         if( head == m_tail.load( std::memory_order_acquire ) ) {
+            return false;
+         }
+         e = m_events[ head & ( Capacity - 1 ) ];
+         m_head.store( head + 1, std::memory_order_release );
+         return true;
+      }
+
+      // Waits for the next event, returns false when the ring was closed and is empty.
+
+      [[nodiscard]] bool pop( event& e ) noexcept
+      {
+         while( !try_pop( e ) ) {
+            if( m_closed.load( std::memory_order_acquire ) ) {
+               return try_pop( e );
+            }
+            std::this_thread::yield();
+         }
+         return true;
+      }
+
+   private:
+      std::unique_ptr< event[] > m_events;
+
+      alignas( 64 ) std::atomic< std::size_t > m_head{ 0 };
+      alignas( 64 ) std::atomic< std::size_t > m_tail{ 0 };
+      std::atomic< bool > m_closed{ false };
+   };
+
+   namespace internal
+   {
+      // Every rule that is called with a rewind_mode other than dontcare, i.e. every rule
+      // whose failure does not imply the failure of the parsing run, remembers the number
+      // of events passed on when it started, in order to retract any later ones when it
+      // fails. Since the sink can't be called during unwinding the rollback is deferred
+      // until the next event, or the end of the parsing run, when an exception was caught.
+
+      template< typename Grammar, typename Sink >
+      struct events_state
+      {
+         static constexpr std::size_t npos = std::size_t( -1 );
+
+         explicit events_state( Sink& in_sink )
+            : sink( in_sink )
+         {}
+
+         Sink& sink;
+         std::vector< std::size_t > begins;
+         std::size_t count = 0;
+         std::size_t unwound = npos;
+         std::uint16_t unwound_rule = 0;
+
+         void rollback( const std::size_t mark, const std::uint16_t rule )
+         {
+            count = mark;
+            sink( event{ mark, mark, rule, event_type::rollback } );
+         }
+
+         void flush()
+         {
+            if( unwound != npos ) {
+               const std::size_t mark = unwound;
+               unwound = npos;
+               if( mark < count ) {
+                  rollback( mark, unwound_rule );
+               }
+            }
+         }
+
+         void emit( const event& e )
+         {
+            flush();
+            sink( e );
+            ++count;
+         }
+
+         void leave_guard( const std::size_t mark, const std::uint16_t rule, const bool result )
+         {
+            flush();
+            if( ( !result ) && ( mark < count ) ) {
+               rollback( mark, rule );
+            }
+         }
+
+         void unwind_guard( const std::size_t mark, const std::uint16_t rule ) noexcept
+         {
+            if( mark <= unwound ) {
+               unwound = mark;
+               unwound_rule = rule;
+            }
+         }
+      };
+
+      template< typename Grammar, typename Sink, template< typename... > class Selector, template< typename... > class Control >
+      struct make_events_control
+      {
+         template< typename Rule, bool, bool >
+         struct state_handler;
+
+         template< typename Rule >
+         using type = rotate_states_right< state_handler< Rule, is_selected_node< Rule, Selector >, is_leaf< 8, typename Rule::subs_t, Selector > > >;
+      };
+
+      template< typename Grammar, typename Rule, template< typename... > class Control >
+      struct events_guard
+         : remove_first_state< Control< Rule > >
+      {
+         static constexpr auto id = std::uint16_t( rule_id_v< Grammar, Rule > );
+
+         template< apply_mode A,
+                   rewind_mode M,
+                   template< typename... >
+                   class Action,
+                   template< typename... >
+                   class Control2,
+                   typename ParseInput,
+                   typename... States >
+         [[nodiscard]] static bool match( ParseInput& in, States&&... st )
+         {
+            if constexpr( M == rewind_mode::dontcare ) {
+               return Control< Rule >::template match< A, M, Action, Control2 >( in, st... );
+            }
+            else {
+               auto& state = std::get< sizeof...( st ) - 1 >( std::tie( st... ) );
+               const std::size_t mark = state.count;
+#if defined( __cpp_exceptions )
+               tao::pegtl::internal::unwind_guard ug( [ & ] {
+                  state.unwind_guard( mark, id );
+               } );
+               const bool result = Control< Rule >::template match< A, M, Action, Control2 >( in, st... );
+               ug.unwind.reset();
+#else
+               const bool result = Control< Rule >::template match< A, M, Action, Control2 >( in, st... );
+#endif
+               state.leave_guard( mark, id, result );
+               return result;
+            }
+         }
+      };
+
+      template< typename Grammar, typename Sink, template< typename... > class Selector, template< typename... > class Control >
+      template< typename Rule >
+      struct make_events_control< Grammar, Sink, Selector, Control >::state_handler< Rule, false, true >
+         : remove_first_state< Control< Rule > >
+      {};
+
+      template< typename Grammar, typename Sink, template< typename... > class Selector, template< typename... > class Control >
+      template< typename Rule >
+      struct make_events_control< Grammar, Sink, Selector, Control >::state_handler< Rule, false, false >
+         : events_guard< Grammar, Rule, Control >
+      {};
+
+      template< typename Grammar, typename Sink, template< typename... > class Selector, template< typename... > class Control >
+      template< typename Rule, bool Leaf >
+      struct make_events_control< Grammar, Sink, Selector, Control >::state_handler< Rule, true, Leaf >
+         : std::conditional_t< Leaf, remove_first_state< Control< Rule > >, events_guard< Grammar, Rule, Control > >
+      {
+         static constexpr auto id = std::uint16_t( rule_id_v< Grammar, Rule > );
+
+         template< typename ParseInput, typename... States >
+         static void start( const ParseInput& in, events_state< Grammar, Sink >& state, States&&... st )
+         {
+            Control< Rule >::start( in, st... );
+            state.begins.push_back( in.byte() );
+            if constexpr( !Leaf ) {
+               state.emit( event{ in.byte(), in.byte(), id, event_type::enter } );
+            }
+         }
+
+         template< typename ParseInput, typename... States >
+         static void success( const ParseInput& in, events_state< Grammar, Sink >& state, States&&... st )
+         {
+            const std::size_t begin = state.begins.back();
+            state.begins.pop_back();
+            state.emit( event{ begin, in.byte(), id, ( Leaf ? event_type::token : event_type::leave ) } );
+            Control< Rule >::success( in, st... );
+         }
+
+         template< typename ParseInput, typename... States >
+         static void failure( const ParseInput& in, events_state< Grammar, Sink >& state, States&&... st )
+         {
+            state.begins.pop_back();
+            Control< Rule >::failure( in, st... );
+         }
+
+         template< typename ParseInput, typename... States >
+         static void unwind( [[maybe_unused]] const ParseInput& in, events_state< Grammar, Sink >& state, States&&... st )
+         {
+            state.begins.pop_back();
+            if constexpr( control_has_unwind< Control< Rule >, const ParseInput&, States... > ) {
+               Control< Rule >::unwind( in, st... );
+            }
+#if defined( _MSC_VER )
+            ( (void)st,
+              ... );
+#endif
+         }
+      };
+
+   }  // namespace internal
+
+   // Like parse_tree::parse() with the same selectors, but instead of creating nodes the
+   // selected rules generate events that are passed to the sink, which is called as
+   // sink( const event& ); the transformers of the selectors are not applied.
+
+   template< typename Rule,
+             template< typename... > class Selector = internal::store_all,
+             template< typename... > class Action = nothing,
+             template< typename... > class Control = normal,
+             typename ParseInput,
+             typename Sink,
+             typename... States >
+   bool parse_events( ParseInput&& in, Sink& sink, States&&... st )
+   {
+      static_assert( rule_list_t< Rule >::size <= 0x10000, "too many rules for parse events" );
+      internal::events_state< Rule, Sink > state( sink );
+      const bool result = tao::pegtl::parse< Rule, Action, internal::make_events_control< Rule, Sink, Selector, Control >::template type >( in, st..., state );
+      state.flush();
+      return result;
+   }
+
+}  // namespace tao::pegtl::parse_tree
+
+#endif
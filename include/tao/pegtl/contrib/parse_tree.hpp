@@ -5,7 +5,9 @@
 #ifndef TAO_PEGTL_CONTRIB_PARSE_TREE_HPP
 #define TAO_PEGTL_CONTRIB_PARSE_TREE_HPP
 
+#include <algorithm>
 #include <cassert>
+#include <cstddef>
 #include <memory>
 #include <string>
 #include <string_view>
@@ -32,11 +34,124 @@
 
 namespace tao::pegtl::parse_tree
 {
-   template< typename T, typename Source = std::string_view >
+   // Monotonic memory for the nodes of parse trees and their arrays of children;
+   // nothing is freed individually, all chunks are freed together by release().
+
+   class node_arena
+   {
+   public:
+      explicit node_arena( const std::size_t chunk_size = 64 * 1024 ) noexcept
+         : m_chunk_size( chunk_size )
+      {}
+
+      node_arena( const node_arena& ) = delete;
+      node_arena( node_arena&& ) = delete;
+
+      ~node_arena()
+      {
+         release();
+      }
+
+      node_arena& operator=( const node_arena& ) = delete;
+      node_arena& operator=( node_arena&& ) = delete;
+
+      [[nodiscard]] void* allocate( const std::size_t size, const std::size_t align )
+      {
+         void* p = m_current;
+         std::size_t space = static_cast< std::size_t >( m_end - m_current );
+         if( std::align( align, size, p, space ) == nullptr ) {
+            grow( size + align );
+            p = m_current;
+            space = static_cast< std::size_t >( m_end - m_current );
+            p = std::align( align, size, p, space );
+            assert( p != nullptr );
+         }
+         m_current = static_cast< char* >( p ) + size;
+         return p;
+      }
+
+      void release() noexcept
+      {
+         while( m_chunks != nullptr ) {
+            chunk* next = m_chunks->next;
+            ::operator delete( m_chunks );
+            m_chunks = next;
+         }
+         m_current = nullptr;
+         m_end = nullptr;
+      }
+
+   private:
+      struct chunk
+      {
+         chunk* next;
+      };
+
+      void grow( const std::size_t minimum )
+      {
+         const std::size_t size = sizeof( chunk ) + ( std::max )( m_chunk_size, minimum );
+         auto* c = static_cast< chunk* >( ::operator new( size ) );
+         c->next = m_chunks;
+         m_chunks = c;
+         m_current = reinterpret_cast< char* >( c + 1 );
+         m_end = reinterpret_cast< char* >( c ) + size;
+      }
+
+      std::size_t m_chunk_size;
+      chunk* m_chunks = nullptr;
+      char* m_current = nullptr;
+      char* m_end = nullptr;
+   };
+
+   template< typename T >
+   class arena_allocator
+   {
+   public:
+      using value_type = T;
+
+      explicit arena_allocator( node_arena& a ) noexcept
+         : m_arena( &a )
+      {}
+
+      template< typename U >
+      arena_allocator( const arena_allocator< U >& other ) noexcept
+         : m_arena( other.arena() )
+      {}
+
+      [[nodiscard]] T* allocate( const std::size_t n )
+      {
+         return static_cast< T* >( m_arena->allocate( n * sizeof( T ), alignof( T ) ) );
+      }
+
+      void deallocate( T* /*unused*/, const std::size_t /*unused*/ ) noexcept
+      {}
+
+      [[nodiscard]] node_arena* arena() const noexcept
+      {
+         return m_arena;
+      }
+
+      template< typename U >
+      [[nodiscard]] bool operator==( const arena_allocator< U >& other ) const noexcept
+      {
+         return m_arena == other.arena();
+      }
+
+      template< typename U >
+      [[nodiscard]] bool operator!=( const arena_allocator< U >& other ) const noexcept
+      {
+         return m_arena != other.arena();
+      }
+
+   private:
+      node_arena* m_arena;
+   };
+
+   template< typename T, typename Source = std::string_view, typename Allocator = std::allocator< std::unique_ptr< T > > >
    struct basic_node
    {
       using node_t = T;
-      using children_t = std::vector< std::unique_ptr< node_t > >;
+      using children_t = std::vector< std::unique_ptr< node_t >, Allocator >;
       children_t children;
 
       std::string_view type;
@@ -48,6 +163,11 @@ namespace tao::pegtl::parse_tree
       // each node will be default constructed
       basic_node() = default;
 
+      // unless the children use an allocator that needs to be given
+      explicit basic_node( const Allocator& a ) noexcept
+         : children( a )
+      {}
+
       // no copy/move is necessary
       // (nodes are always owned/handled by a std::unique_ptr)
       basic_node( const basic_node& ) = delete;
@@ -154,21 +274,82 @@ namespace tao::pegtl::parse_tree
       : basic_node< node >
    {};
 
+   // Nodes that are created in a node_arena together with their arrays of children,
+   // wherefore no memory is freed when nodes are destroyed, and that must therefore
+   // not outlive the arena; see parse() with a node_arena as first argument. The
+   // nodes of a tree returned by parse() are never destroyed, and destroying a node
+   // that was removed from a tree does not destroy its children.
+
+   template< typename T, typename Source = std::string_view >
+   struct basic_arena_node
+      : basic_node< T, Source, arena_allocator< std::unique_ptr< T > > >
+   {
+      static_assert( std::is_trivially_destructible_v< Source >, "arena nodes are not destroyed" );
+
+      explicit basic_arena_node( node_arena& a ) noexcept
+         : basic_node< T, Source, arena_allocator< std::unique_ptr< T > > >( arena_allocator< std::unique_ptr< T > >( a ) )
+      {}
+
+      basic_arena_node( const basic_arena_node& ) = delete;
+      basic_arena_node( basic_arena_node&& ) = delete;
+
+      ~basic_arena_node()
+      {
+         for( auto& child : this->children ) {
+            (void)child.release();
+         }
+      }
+
+      basic_arena_node& operator=( const basic_arena_node& ) = delete;
+      basic_arena_node& operator=( basic_arena_node&& ) = delete;
+
+      [[nodiscard]] static void* operator new( const std::size_t size, node_arena& a )
+      {
+         return a.allocate( size, alignof( T ) );
+      }
+
+      static void operator delete( void* /*unused*/, node_arena& /*unused*/ ) noexcept
+      {}
+
+      static void operator delete( void* /*unused*/ ) noexcept
+      {}
+   };
+
+   struct arena_node
+      : basic_arena_node< arena_node >
+   {
+      using basic_arena_node::basic_arena_node;
+   };
+
    namespace internal
    {
       template< typename Node >
       struct state
       {
          std::vector< std::unique_ptr< Node > > stack;
+         std::vector< std::size_t > marks;
+         node_arena* arena = nullptr;
 
          state()
          {
             emplace_back();
          }
 
+         explicit state( node_arena& a )
+            : arena( &a )
+         {
+            emplace_back();
+         }
+
          void emplace_back()
          {
-            stack.emplace_back( std::make_unique< Node >() );
+            if constexpr( std::is_constructible_v< Node, node_arena& > ) {
+               assert( arena != nullptr );
+               stack.emplace_back( new( *arena ) Node( *arena ) );
+            }
+            else {
+               stack.emplace_back( std::make_unique< Node >() );
+            }
          }
 
          [[nodiscard]] std::unique_ptr< Node >& back() noexcept
@@ -182,6 +363,28 @@ namespace tao::pegtl::parse_tree
             assert( !stack.empty() );
             return stack.pop_back();
          }
+
+         // Rules that are not selected add the nodes of their selected sub-rules directly
+         // to the current node; on failure they are removed by truncating to the mark.
+
+         void mark()
+         {
+            marks.emplace_back( back()->children.size() );
+         }
+
+         void unmark() noexcept
+         {
+            assert( !marks.empty() );
+            marks.pop_back();
+         }
+
+         void restore()
+         {
+            assert( !marks.empty() );
+            auto& children = back()->children;
+            children.erase( children.begin() + marks.back(), children.end() );
+            marks.pop_back();
+         }
       };
 
       template< typename Selector, typename... Parameters >
@@ -256,29 +459,25 @@ namespace tao::pegtl::parse_tree
          template< typename ParseInput, typename... States >
          static void start( const ParseInput& /*unused*/, state< Node >& state, States&&... /*unused*/ )
          {
-            state.emplace_back();
+            state.mark();
          }
 
          template< typename ParseInput, typename... States >
          static void success( const ParseInput& /*unused*/, state< Node >& state, States&&... /*unused*/ )
          {
-            auto n = std::move( state.back() );
-            state.pop_back();
-            for( auto& c : n->children ) {
-               state.back()->children.emplace_back( std::move( c ) );
-            }
+            state.unmark();
          }
 
          template< typename ParseInput, typename... States >
          static void failure( const ParseInput& /*unused*/, state< Node >& state, States&&... /*unused*/ )
          {
-            state.pop_back();
+            state.restore();
          }
 
          template< typename ParseInput, typename... States >
          static void unwind( const ParseInput& /*unused*/, state< Node >& state, States&&... /*unused*/ )
          {
-            state.pop_back();
+            state.restore();
          }
       };
 
@@ -433,14 +632,37 @@ namespace tao::pegtl::parse_tree
              typename... States >
    [[nodiscard]] std::unique_ptr< Node > parse( ParseInput&& in, States&&... st )
    {
+      static_assert( !std::is_constructible_v< Node, node_arena& >, "arena nodes require a node_arena" );
       internal::state< Node > state;
       if( !tao::pegtl::parse< Rule, Action, internal::make_control< Node, Selector, Control >::template type >( in, st..., state ) ) {
          return nullptr;
       }
       assert( state.stack.size() == 1 );
+      assert( state.marks.empty() );
       return std::move( state.back() );
    }
 
+   // The returned root does not own the tree, all nodes are freed together when the
+   // arena is destroyed or released, without calling their destructors.
+
+   template< typename Rule,
+             typename Node,
+             template< typename... > class Selector = internal::store_all,
+             template< typename... > class Action = nothing,
+             template< typename... > class Control = normal,
+             typename ParseInput,
+             typename... States >
+   [[nodiscard]] Node* parse( node_arena& arena, ParseInput&& in, States&&... st )
+   {
+      internal::state< Node > state( arena );
+      if( !tao::pegtl::parse< Rule, Action, internal::make_control< Node, Selector, Control >::template type >( in, st..., state ) ) {
+         return nullptr;
+      }
+      assert( state.stack.size() == 1 );
+      assert( state.marks.empty() );
+      return state.back().release();
+   }
+
    template< typename Rule,
              template< typename... > class Selector = internal::store_all,
              template< typename... > class Action = nothing,
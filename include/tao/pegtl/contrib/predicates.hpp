@@ -8,6 +8,7 @@
 #include "../type_list.hpp"
 
 #include "../internal/bump_help.hpp"
+#include "../internal/char_class.hpp"
 #include "../internal/dependent_false.hpp"
 #include "../internal/enable_control.hpp"
 #include "../internal/failure.hpp"
@@ -68,14 +69,24 @@ namespace tao::pegtl
 
          using base_t = Test< Peek, Ps... >;
 
-         [[nodiscard]] static constexpr bool test_one( const data_t c ) noexcept
+         [[nodiscard]] static constexpr bool test_compare( const data_t c ) noexcept
          {
             return Test< Peek, Ps... >::test_impl( c );
          }
 
+         [[nodiscard]] static constexpr bool test_one( const data_t c ) noexcept
+         {
+            if constexpr( char_class_peek< Peek > ) {
+               return char_class_v< predicates >.test( static_cast< unsigned char >( c ) );
+            }
+            else {
+               return test_compare( c );
+            }
+         }
+
          [[nodiscard]] static constexpr bool test_any( const data_t c ) noexcept
          {
-            return Test< Peek, Ps... >::test_impl( c );
+            return test_one( c );
          }
 
          template< typename ParseInput >
@@ -0,0 +1,218 @@
+// Copyright (c) 2023 Dr. Colin Hirsch and Daniel Frey
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef TAO_PEGTL_CONTRIB_PUSH_PARSER_HPP
+#define TAO_PEGTL_CONTRIB_PUSH_PARSER_HPP
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <cstring>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include "../buffer_input.hpp"
+#include "../eol.hpp"
+#include "../normal.hpp"
+#include "../nothing.hpp"
+#include "../parse.hpp"
+
+namespace tao::pegtl
+{
+   namespace internal
+   {
+      // Hands the data passed to feed() to the parsing thread, one fragment at a time.
+
+      class push_channel
+      {
+      public:
+         push_channel() = default;
+
+         push_channel( const push_channel& ) = delete;
+         push_channel( push_channel&& ) = delete;
+
+         ~push_channel() = default;
+
+         push_channel& operator=( const push_channel& ) = delete;
+         push_channel& operator=( push_channel&& ) = delete;
+
+         [[nodiscard]] std::size_t read( char* buffer, const std::size_t length )
+         {
+            std::unique_lock< std::mutex > lock( m_mutex );
+            if( ( m_size == 0 ) && ( !m_eof ) ) {
+               m_hungry = true;
+               m_idle.notify_one();
+               m_more.wait( lock, [ this ] { return ( m_size != 0 ) || m_eof; } );
+               m_hungry = false;
+            }
+            const std::size_t n = ( std::min )( length, m_size );
+            std::memcpy( buffer, m_data, n );
+            m_data += n;
+            m_size -= n;
+            return n;
+         }
+
+         // Blocks until the parsing thread has consumed all the data and waits for more, or has finished.
+
+         void feed( const char* data, const std::size_t size )
+         {
+            std::unique_lock< std::mutex > lock( m_mutex );
+            m_data = data;
+            m_size = size;
+            m_more.notify_one();
+            m_idle.wait( lock, [ this ] { return ( ( m_size == 0 ) && m_hungry ) || m_done; } );
+            m_size = 0;
+         }
+
+         void finish()
+         {
+            const std::lock_guard< std::mutex > lock( m_mutex );
+            m_eof = true;
+            m_more.notify_one();
+         }
+
+         void done()
+         {
+            const std::lock_guard< std::mutex > lock( m_mutex );
+            m_done = true;
+            m_idle.notify_one();
+         }
+
+         [[nodiscard]] bool is_done()
+         {
+            const std::lock_guard< std::mutex > lock( m_mutex );
+            return m_done;
+         }
+
+      private:
+         std::mutex m_mutex;
+         std::condition_variable m_more;
+         std::condition_variable m_idle;
+         const char* m_data = nullptr;
+         std::size_t m_size = 0;
+         bool m_hungry = false;
+         bool m_eof = false;
+         bool m_done = false;
+      };
+
+      struct push_reader
+      {
+         explicit push_reader( push_channel* channel ) noexcept
+            : m_channel( channel )
+         {}
+
+         [[nodiscard]] std::size_t operator()( char* buffer, const std::size_t length ) const
+         {
+            return m_channel->read( buffer, length );
+         }
+
+         push_channel* m_channel;
+      };
+
+   }  // namespace internal
+
+   // Parses data that arrives in fragments passed to feed(), without having to
+   // collect it first. Since C++17 has no coroutines the grammar runs on its own
+   // thread, with a buffer_input<> whose reader suspends the parsing thread when
+   // it needs more data than was fed so far. The fed data is copied into the buffer
+   // of the input as needed; each call to feed() returns when all of its data was
+   // copied and the parser waits for more, or has finished, so that the data can be
+   // reused by the caller, and all actions for it have been applied.
+   // The states are used by reference on the parsing thread and must outlive the
+   // push_parser; calling finish() signals the end of the input and returns the
+   // result of the parse, or re-throws the exception that terminated it.
+
+   template< typename Rule,
+             template< typename... > class Action = nothing,
+             template< typename... > class Control = normal,
+             typename Eol = eol::lf_crlf,
+             std::size_t Chunk = 64 >
+   class push_parser
+   {
+   public:
+      using input_t = buffer_input< internal::push_reader, Eol, std::string, Chunk >;
+
+      template< typename... States >
+      push_parser( const std::string& source, const std::size_t maximum, States&... st )
+         : m_input( source, maximum, &m_channel ),
+           m_thread( [ this, &st... ] { run( st... ); } )
+      {}
+
+      push_parser( const push_parser& ) = delete;
+      push_parser( push_parser&& ) = delete;
+
+      ~push_parser()
+      {
+         if( m_thread.joinable() ) {
+            m_channel.finish();
+            m_thread.join();
+         }
+      }
+
+      push_parser& operator=( const push_parser& ) = delete;
+      push_parser& operator=( push_parser&& ) = delete;
+
+      void feed( const char* data, const std::size_t size )
+      {
+         if( size != 0 ) {
+            m_channel.feed( data, size );
+         }
+      }
+
+      void feed( const std::string_view data )
+      {
+         feed( data.data(), data.size() );
+      }
+
+      [[nodiscard]] bool finished()
+      {
+         return m_channel.is_done();
+      }
+
+      bool finish()
+      {
+         if( m_thread.joinable() ) {
+            m_channel.finish();
+            m_thread.join();
+         }
+#if defined( __cpp_exceptions )
+         if( m_error ) {
+            std::rethrow_exception( m_error );
+         }
+#endif
+         return m_result;
+      }
+
+   private:
+      template< typename... States >
+      void run( States&... st )
+      {
+#if defined( __cpp_exceptions )
+         try {
+            m_result = pegtl::parse< Rule, Action, Control >( m_input, st... );
+         }
+         catch( ... ) {
+            m_error = std::current_exception();
+         }
+#else
+         m_result = pegtl::parse< Rule, Action, Control >( m_input, st... );
+#endif
+         m_channel.done();
+      }
+
+      internal::push_channel m_channel;
+      input_t m_input;
+      bool m_result = false;
+#if defined( __cpp_exceptions )
+      std::exception_ptr m_error;
+#endif
+      std::thread m_thread;
+   };
+
+}  // namespace tao::pegtl
+
+#endif
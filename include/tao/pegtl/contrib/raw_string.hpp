@@ -13,6 +13,9 @@
 #include "../rewind_mode.hpp"
 #include "../rules.hpp"
 
+#include "../internal/first_set.hpp"
+#include "../internal/until.hpp"
+
 #include "analyze_traits.hpp"
 
 namespace tao::pegtl
@@ -93,6 +96,15 @@ namespace tao::pegtl
       template< char Marker, char Close >
       inline constexpr bool enable_control< at_raw_string_close< Marker, Close > > = false;
 
+      template< char Marker, char Close >
+      struct first_traits< at_raw_string_close< Marker, Close > >
+      {
+         [[nodiscard]] static constexpr first_set get() noexcept
+         {
+            return first_set_test( []( const char c ) { return c == Close; } );
+         }
+      };
+
       template< typename Cond, typename... Rules >
       struct raw_string_until
          : raw_string_until< Cond, seq< Rules... > >
@@ -115,14 +127,7 @@ namespace tao::pegtl
          [[nodiscard]] static bool match( ParseInput& in, const std::size_t& marker_size, States&&... /*unused*/ )
          {
             auto m = in.template auto_rewind< M >();
-
-            while( !Control< Cond >::template match< A, rewind_mode::required, Action, Control >( in, marker_size ) ) {
-               if( in.empty() ) {
-                  return false;
-               }
-               in.bump();
-            }
-            return m( true );
+            return m( until_match< Cond, A, Action, Control >( in, marker_size ) );
          }
       };
 
@@ -0,0 +1,160 @@
+// Copyright (c) 2023 Dr. Colin Hirsch and Daniel Frey
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef TAO_PEGTL_CONTRIB_READAHEAD_READER_HPP
+#define TAO_PEGTL_CONTRIB_READAHEAD_READER_HPP
+
+#include <algorithm>
+#include <array>
+#include <condition_variable>
+#include <cstddef>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace tao::pegtl
+{
+   // Reader adapter for buffer_input<> that calls the wrapped Reader on a
+   // worker thread to fill up to Depth chunks of Size bytes in advance.
+   // Only waits for the worker when no data is available, i.e. returns
+   // whatever was already read instead of waiting to fill the request.
+   // Exceptions thrown by the wrapped reader are re-thrown by operator()
+   // after all data read before the exception has been consumed.
+   // Note that the destructor has to wait for a pending read to return.
+
+   template< typename Reader, std::size_t Depth = 2, std::size_t Size = 64 * 1024 >
+   class readahead_reader
+   {
+   public:
+      static_assert( Depth != 0, "zero readahead depth not implemented" );
+      static_assert( Size != 0, "zero readahead size not implemented" );
+
+      template< typename... As >
+      explicit readahead_reader( As&&... as )
+         : m_reader( std::forward< As >( as )... ),
+           m_buffer( new char[ Depth * Size ] ),
+           m_thread( [ this ] { work(); } )
+      {}
+
+      readahead_reader( const readahead_reader& ) = delete;
+      readahead_reader( readahead_reader&& ) = delete;
+
+      ~readahead_reader()
+      {
+         {
+            const std::lock_guard< std::mutex > lock( m_mutex );
+            m_stop = true;
+         }
+         m_freed.notify_one();
+         m_thread.join();
+      }
+
+      readahead_reader& operator=( const readahead_reader& ) = delete;
+      readahead_reader& operator=( readahead_reader&& ) = delete;
+
+      [[nodiscard]] std::size_t operator()( char* buffer, const std::size_t length )
+      {
+         std::size_t result = 0;
+         while( result < length ) {
+            if( !m_active ) {
+               std::unique_lock< std::mutex > lock( m_mutex );
+               if( result == 0 ) {
+                  m_filled.wait( lock, [ this ] { return ( m_count != 0 ) || m_done; } );
+               }
+               if( m_count == 0 ) {
+#if defined( __cpp_exceptions )
+                  if( m_error && ( result == 0 ) ) {
+                     std::rethrow_exception( std::exchange( m_error, nullptr ) );
+                  }
+#endif
+                  break;
+               }
+               m_active = true;
+               m_offset = 0;
+            }
+            const std::size_t size = m_sizes[ m_head ];
+            const std::size_t n = ( std::min )( length - result, size - m_offset );
+            std::memcpy( buffer + result, m_buffer.get() + m_head * Size + m_offset, n );
+            result += n;
+            m_offset += n;
+            if( m_offset == size ) {
+               {
+                  const std::lock_guard< std::mutex > lock( m_mutex );
+                  m_head = ( m_head + 1 ) % Depth;
+                  --m_count;
+               }
+               m_active = false;
+               m_freed.notify_one();
+            }
+         }
+         return result;
+      }
+
+   private:
+      void work()
+      {
+         std::size_t tail = 0;
+         while( true ) {
+            {
+               std::unique_lock< std::mutex > lock( m_mutex );
+               m_freed.wait( lock, [ this ] { return m_stop || ( m_count < Depth ); } );
+               if( m_stop ) {
+                  return;
+               }
+            }
+            std::size_t size = 0;
+#if defined( __cpp_exceptions )
+            try {
+               size = m_reader( m_buffer.get() + tail * Size, Size );
+            }
+            catch( ... ) {
+               const std::lock_guard< std::mutex > lock( m_mutex );
+               m_error = std::current_exception();
+               m_done = true;
+               m_filled.notify_one();
+               return;
+            }
+#else
+            size = m_reader( m_buffer.get() + tail * Size, Size );
+#endif
+            const std::lock_guard< std::mutex > lock( m_mutex );
+            if( size == 0 ) {
+               m_done = true;
+               m_filled.notify_one();
+               return;
+            }
+            m_sizes[ tail ] = size;
+            ++m_count;
+            m_filled.notify_one();
+            tail = ( tail + 1 ) % Depth;
+         }
+      }
+
+      Reader m_reader;
+      std::unique_ptr< char[] > m_buffer;
+      std::array< std::size_t, Depth > m_sizes = {};
+
+      // Only accessed by the parsing thread.
+      bool m_active = false;
+      std::size_t m_offset = 0;
+
+      // Shared between both threads, guarded by m_mutex.
+      std::mutex m_mutex;
+      std::condition_variable m_filled;
+      std::condition_variable m_freed;
+      std::size_t m_head = 0;
+      std::size_t m_count = 0;
+      bool m_done = false;
+      bool m_stop = false;
+      std::exception_ptr m_error;
+
+      std::thread m_thread;
+   };
+
+}  // namespace tao::pegtl
+
+#endif
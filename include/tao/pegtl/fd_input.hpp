@@ -0,0 +1,34 @@
+// Copyright (c) 2023 Dr. Colin Hirsch and Daniel Frey
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef TAO_PEGTL_FD_INPUT_HPP
+#define TAO_PEGTL_FD_INPUT_HPP
+
+#include <cstddef>
+#include <string>
+#include <utility>
+
+#include "buffer_input.hpp"
+#include "eol.hpp"
+
+#include "internal/fd_reader.hpp"
+
+namespace tao::pegtl
+{
+   template< typename Eol = eol::lf_crlf, std::size_t Chunk = 64 * 1024 >
+   struct fd_input
+      : buffer_input< internal::fd_reader, Eol, std::string, Chunk >
+   {
+      template< typename T >
+      fd_input( const int in_fd, const std::size_t in_maximum, T&& in_source )
+         : buffer_input< internal::fd_reader, Eol, std::string, Chunk >( std::forward< T >( in_source ), in_maximum, in_fd )
+      {}
+   };
+
+   template< typename... Ts >
+   fd_input( Ts&&... ) -> fd_input<>;
+
+}  // namespace tao::pegtl
+
+#endif
@@ -24,12 +24,12 @@ namespace tao::pegtl::internal
       using rule_t = any;
       using subs_t = empty_list;
 
-      [[nodiscard]] static bool test_one( const char /*unused*/ ) noexcept
+      [[nodiscard]] static constexpr bool test_one( const char /*unused*/ ) noexcept
       {
          return true;
       }
 
-      [[nodiscard]] static bool test_any( const char /*unused*/ ) noexcept
+      [[nodiscard]] static constexpr bool test_any( const char /*unused*/ ) noexcept
       {
          return true;
       }
@@ -0,0 +1,198 @@
+// Copyright (c) 2023 Dr. Colin Hirsch and Daniel Frey
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef TAO_PEGTL_INTERNAL_BUFFER_INPUT_BASE_HPP
+#define TAO_PEGTL_INTERNAL_BUFFER_INPUT_BASE_HPP
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#if defined( __cpp_exceptions )
+#include <stdexcept>
+#else
+#include <cstdio>
+#include <exception>
+#endif
+
+#include "bump.hpp"
+#include "frobnicator.hpp"
+#include "rewind_guard.hpp"
+
+#include "../position.hpp"
+#include "../rewind_mode.hpp"
+#include "../tracking_mode.hpp"
+
+namespace tao::pegtl::internal
+{
+   // Common part of the inputs that only hold a window of the data in a buffer, i.e.
+   // everything except for the management of the buffer itself. The derived Input
+   // provides require(), discard() and the buffer_*() functions, and initialises
+   // m_current with the beginning of the buffer in its constructor.
+
+   template< typename Input, typename Eol, typename Source >
+   class buffer_input_base
+   {
+   public:
+      using eol_t = Eol;
+      using source_t = Source;
+
+      using frobnicator_t = internal::frobnicator;
+
+      static constexpr tracking_mode tracking_mode_v = tracking_mode::eager;
+
+      template< typename T >
+      explicit buffer_input_base( T&& in_source )
+         : m_source( std::forward< T >( in_source ) )
+      {}
+
+      buffer_input_base( const buffer_input_base& ) = delete;
+      buffer_input_base( buffer_input_base&& ) = delete;
+
+      ~buffer_input_base() = default;
+
+      buffer_input_base& operator=( const buffer_input_base& ) = delete;
+      buffer_input_base& operator=( buffer_input_base&& ) = delete;
+
+      [[nodiscard]] bool empty()
+      {
+         return size( 1 ) == 0;
+      }
+
+      [[nodiscard]] std::size_t size( const std::size_t amount )
+      {
+         derived().require( amount );
+         return derived().buffer_occupied();
+      }
+
+      [[nodiscard]] const char* current() const noexcept
+      {
+         return m_current.data;
+      }
+
+      [[nodiscard]] const char* end( const std::size_t amount )
+      {
+         return m_current.data + size( amount );
+      }
+
+      [[nodiscard]] std::size_t byte() const noexcept
+      {
+         return m_current.byte;
+      }
+
+      [[nodiscard]] std::size_t line() const noexcept
+      {
+         return m_current.line;
+      }
+
+      [[nodiscard]] std::size_t column() const noexcept
+      {
+         return m_current.column;
+      }
+
+      [[nodiscard]] const Source& source() const noexcept
+      {
+         return m_source;
+      }
+
+      [[nodiscard]] char peek_char( const std::size_t offset = 0 ) const noexcept
+      {
+         return m_current.data[ offset ];
+      }
+
+      [[nodiscard]] std::uint8_t peek_uint8( const std::size_t offset = 0 ) const noexcept
+      {
+         return static_cast< std::uint8_t >( peek_char( offset ) );
+      }
+
+      void bump( const std::size_t in_count = 1 ) noexcept
+      {
+         internal::bump( m_current, in_count, Eol::ch );
+      }
+
+      void bump_in_this_line( const std::size_t in_count = 1 ) noexcept
+      {
+         internal::bump_in_this_line( m_current, in_count );
+      }
+
+      void bump_to_next_line( const std::size_t in_count = 1 ) noexcept
+      {
+         internal::bump_to_next_line( m_current, in_count );
+      }
+
+      template< rewind_mode M >
+      [[nodiscard]] internal::rewind_guard< M, Input > auto_rewind() noexcept
+      {
+         return internal::rewind_guard< M, Input >( &derived() );
+      }
+
+      [[nodiscard]] const frobnicator_t& rewind_save() noexcept
+      {
+         return m_current;
+      }
+
+      void rewind_restore( const frobnicator_t& data ) noexcept
+      {
+         m_current = data;
+      }
+
+      void rewind_enter() noexcept
+      {
+         ++m_rewind;
+      }
+
+      void rewind_leave() noexcept
+      {
+         assert( m_rewind > 0 );
+         --m_rewind;
+      }
+
+      [[nodiscard]] std::size_t rewind_depth() const noexcept
+      {
+         return m_rewind;
+      }
+
+      [[nodiscard]] tao::pegtl::position position( const frobnicator_t& it ) const
+      {
+         return tao::pegtl::position( it, m_source );
+      }
+
+      [[nodiscard]] tao::pegtl::position position() const
+      {
+         return position( m_current );
+      }
+
+      [[nodiscard]] const frobnicator_t& frobnicator() const noexcept
+      {
+         return m_current;
+      }
+
+   protected:
+      [[nodiscard]] Input& derived() noexcept
+      {
+         return static_cast< Input& >( *this );
+      }
+
+      [[noreturn]] static void require_overflow()
+      {
+#if defined( __cpp_exceptions )
+         throw std::overflow_error( "require() beyond end of buffer" );
+#else
+         std::fputs( "overflow error: require() beyond end of buffer\n", stderr );
+         std::terminate();
+#endif
+      }
+
+      frobnicator_t m_current;
+      const Source m_source;
+      std::size_t m_rewind = 0;
+
+   public:
+      std::size_t private_depth = 0;
+   };
+
+}  // namespace tao::pegtl::internal
+
+#endif
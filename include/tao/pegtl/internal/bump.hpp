@@ -1,25 +1,120 @@
-// Copyright (c) 2017-2022 Dr. Colin Hirsch and Daniel Frey
+// Copyright (c) 2017-2023 Dr. Colin Hirsch and Daniel Frey
 // Distributed under the Boost Software License, Version 1.0.
 // (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
 
 #ifndef TAO_PEGTL_INTERNAL_BUMP_HPP
 #define TAO_PEGTL_INTERNAL_BUMP_HPP
 
+#include <cstddef>
+
+#if defined( __SSE2__ ) && ( defined( __GNUC__ ) || defined( __clang__ ) )
+#include <immintrin.h>
+#endif
+
 #include "frobnicator.hpp"
 
 namespace tao::pegtl::internal
 {
-   inline void bump( frobnicator& iter, const std::size_t count, const int ch ) noexcept
+   struct lines_and_last
    {
+      std::size_t lines = 0;
+      std::size_t last = 0;  // Index of the last occurrence plus one, or zero when lines is zero.
+   };
+
+   // Counts the occurrences of ch in [data, data + count) and finds the last one in a single pass.
+
+   [[nodiscard]] inline lines_and_last scan_lines_scalar( const char* data, const std::size_t count, const char ch ) noexcept
+   {
+      lines_and_last r;
       for( std::size_t i = 0; i < count; ++i ) {
-         if( iter.data[ i ] == ch ) {
-            ++iter.line;
-            iter.column = 1;
+         if( data[ i ] == ch ) {
+            ++r.lines;
+            r.last = i + 1;
          }
-         else {
-            ++iter.column;
+      }
+      return r;
+   }
+
+#if defined( __SSE2__ ) && ( defined( __GNUC__ ) || defined( __clang__ ) )
+
+   // The vector loops accumulate per-lane match counts with byte-wise subtraction of the
+   // comparison results, which are flushed before they can overflow, and only remember the
+   // mask of the last block with a match so that the position is determined once at the end.
+
+   [[nodiscard]] inline std::size_t scan_lines_flush( const __m128i acc ) noexcept
+   {
+      const __m128i sum = _mm_sad_epu8( acc, _mm_setzero_si128() );
+      return static_cast< std::size_t >( _mm_cvtsi128_si32( sum ) ) + static_cast< std::size_t >( _mm_extract_epi16( sum, 4 ) );
+   }
+
+   [[nodiscard]] inline lines_and_last scan_lines( const char* data, const std::size_t count, const char ch ) noexcept
+   {
+      lines_and_last r;
+      std::size_t i = 0;
+      std::size_t last_block = 0;
+      unsigned last_mask = 0;
+#if defined( __AVX2__ )
+      if( count >= 32 ) {
+         const __m256i c = _mm256_set1_epi8( ch );
+         while( i + 32 <= count ) {
+            __m256i acc = _mm256_setzero_si256();
+            for( unsigned n = 0; ( n < 255 ) && ( i + 32 <= count ); ++n, i += 32 ) {
+               const __m256i m = _mm256_cmpeq_epi8( _mm256_loadu_si256( reinterpret_cast< const __m256i* >( data + i ) ), c );
+               acc = _mm256_sub_epi8( acc, m );
+               if( const auto mask = static_cast< unsigned >( _mm256_movemask_epi8( m ) ) ) {
+                  last_block = i;
+                  last_mask = mask;
+               }
+            }
+            r.lines += scan_lines_flush( _mm256_castsi256_si128( acc ) ) + scan_lines_flush( _mm256_extracti128_si256( acc, 1 ) );
          }
       }
+#endif
+      if( i + 16 <= count ) {
+         const __m128i c = _mm_set1_epi8( ch );
+         while( i + 16 <= count ) {
+            __m128i acc = _mm_setzero_si128();
+            for( unsigned n = 0; ( n < 255 ) && ( i + 16 <= count ); ++n, i += 16 ) {
+               const __m128i m = _mm_cmpeq_epi8( _mm_loadu_si128( reinterpret_cast< const __m128i* >( data + i ) ), c );
+               acc = _mm_sub_epi8( acc, m );
+               if( const auto mask = static_cast< unsigned >( _mm_movemask_epi8( m ) ) ) {
+                  last_block = i;
+                  last_mask = mask;
+               }
+            }
+            r.lines += scan_lines_flush( acc );
+         }
+      }
+      if( last_mask != 0 ) {
+         r.last = last_block + 32 - static_cast< std::size_t >( __builtin_clz( last_mask ) );
+      }
+      if( i < count ) {
+         const auto t = scan_lines_scalar( data + i, count - i, ch );
+         r.lines += t.lines;
+         r.last = ( t.lines != 0 ) ? ( i + t.last ) : r.last;
+      }
+      return r;
+   }
+
+#else
+
+   [[nodiscard]] inline lines_and_last scan_lines( const char* data, const std::size_t count, const char ch ) noexcept
+   {
+      return scan_lines_scalar( data, count, ch );
+   }
+
+#endif
+
+   inline void bump( frobnicator& iter, const std::size_t count, const int ch ) noexcept
+   {
+      const auto r = scan_lines( iter.data, count, static_cast< char >( ch ) );
+      if( r.lines != 0 ) {
+         iter.line += r.lines;
+         iter.column = count - r.last + 1;
+      }
+      else {
+         iter.column += count;
+      }
       iter.byte += count;
       iter.data += count;
    }
@@ -0,0 +1,184 @@
+// Copyright (c) 2023 Dr. Colin Hirsch and Daniel Frey
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef TAO_PEGTL_INTERNAL_CHAR_CLASS_HPP
+#define TAO_PEGTL_INTERNAL_CHAR_CLASS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#if defined( __SSSE3__ ) && ( defined( __GNUC__ ) || defined( __clang__ ) )
+#include <immintrin.h>
+#endif
+
+#include "bump_help.hpp"
+#include "peek_char.hpp"
+#include "unobserved.hpp"
+
+#include "../apply_mode.hpp"
+
+namespace tao::pegtl::internal
+{
+   // A set of bytes as 256-bit bitmap that tests membership with a single load
+   // instead of the chain of comparisons of a rule's test_compare() function;
+   // used by the character class rules with more than a few comparisons when
+   // the peek yields single bytes. The same set is also stored as two tables
+   // indexed by the low nibble of a byte that contain one bit for each value
+   // of the high nibble, the layout required by the vectorised scan below.
+
+   struct char_class
+   {
+      std::uint64_t bits[ 4 ] = {};
+      char low[ 16 ] = {};   // Bit h of low[ l ] is set when byte h * 16 + l is in the set, for h < 8.
+      char high[ 16 ] = {};  // Bit h of high[ l ] is set when byte h * 16 + l + 128 is in the set.
+
+      [[nodiscard]] constexpr bool test( const unsigned char c ) const noexcept
+      {
+         return ( ( bits[ c >> 6 ] >> ( c & 63 ) ) & 1 ) != 0;
+      }
+
+      constexpr void insert( const std::size_t c ) noexcept
+      {
+         bits[ c >> 6 ] |= std::uint64_t( 1 ) << ( c & 63 );
+         char& nibble = ( c < 128 ) ? low[ c & 15 ] : high[ c & 15 ];
+         nibble = static_cast< char >( nibble | ( 1 << ( ( c >> 4 ) & 7 ) ) );
+      }
+   };
+
+   template< typename Peek >
+   inline constexpr bool char_class_peek = ( sizeof( typename Peek::data_t ) == 1 );
+
+   template< typename Rule, bool Compare = true >
+   [[nodiscard]] constexpr char_class char_class_make() noexcept
+   {
+      using data_t = typename Rule::data_t;
+      char_class r;
+      for( std::size_t i = 0; i < 256; ++i ) {
+         const auto c = static_cast< data_t >( static_cast< unsigned char >( i ) );
+         if constexpr( Compare ) {
+            if( Rule::test_compare( c ) ) {
+               r.insert( i );
+            }
+         }
+         else {
+            if( Rule::test_one( c ) ) {
+               r.insert( i );
+            }
+         }
+      }
+      return r;
+   }
+
+   template< typename Rule >
+   inline constexpr char_class char_class_v = char_class_make< Rule >();
+
+   // Rules that match a single byte with a peek_char; star and plus scan runs of matching bytes
+   // with match_char_class() when no control functions or actions are called for the Rule.
+
+   template< typename Rule, typename = void >
+   inline constexpr bool char_class_rule = false;
+
+   template< typename Rule >
+   inline constexpr bool char_class_rule< Rule, std::void_t< typename Rule::peek_t > > = std::is_same_v< typename Rule::peek_t, peek_char >;
+
+   template< typename Rule, apply_mode A, template< typename... > class Action, template< typename... > class Control >
+   inline constexpr bool char_class_scan = char_class_rule< Rule > && unobserved< Rule, A, Action, Control >;
+
+   template< typename Rule >
+   inline constexpr char_class char_class_rule_v = char_class_make< Rule, false >();
+
+   // Returns the length of the longest prefix of [data, data + count) with only bytes matched by Rule.
+
+   template< typename Rule >
+   [[nodiscard]] std::size_t scan_char_class_scalar( const char* data, const std::size_t count ) noexcept
+   {
+      std::size_t i = 0;
+      while( ( i < count ) && Rule::test_one( data[ i ] ) ) {
+         ++i;
+      }
+      return i;
+   }
+
+#if defined( __SSSE3__ ) && ( defined( __GNUC__ ) || defined( __clang__ ) )
+
+   // The vector loops look up the bits for the high nibbles of all bytes in the tables for their
+   // low nibbles with a byte shuffle; bytes with the top bit set select the zeroes of the shuffle
+   // into the low table, and vice versa for the high table, so that the results can be combined.
+
+   [[nodiscard]] inline __m128i scan_char_class_block( const __m128i low, const __m128i high, const __m128i v ) noexcept
+   {
+      const __m128i index = _mm_and_si128( v, _mm_set1_epi8( static_cast< char >( 0x8f ) ) );
+      const __m128i row = _mm_or_si128( _mm_shuffle_epi8( low, index ), _mm_shuffle_epi8( high, _mm_xor_si128( index, _mm_set1_epi8( static_cast< char >( 0x80 ) ) ) ) );
+      const __m128i bit = _mm_shuffle_epi8( _mm_set1_epi64x( static_cast< long long >( 0x8040201008040201 ) ), _mm_and_si128( _mm_srli_epi16( v, 4 ), _mm_set1_epi8( 0x0f ) ) );
+      return _mm_cmpeq_epi8( _mm_and_si128( row, bit ), bit );
+   }
+
+   template< typename Rule >
+   [[nodiscard]] std::size_t scan_char_class( const char* data, const std::size_t count ) noexcept
+   {
+      constexpr const char_class& cc = char_class_rule_v< Rule >;
+      std::size_t i = 0;
+#if defined( __AVX2__ )
+      if( count >= 32 ) {
+         const __m256i low = _mm256_broadcastsi128_si256( _mm_loadu_si128( reinterpret_cast< const __m128i* >( cc.low ) ) );
+         const __m256i high = _mm256_broadcastsi128_si256( _mm_loadu_si128( reinterpret_cast< const __m128i* >( cc.high ) ) );
+         const __m256i bits = _mm256_set1_epi64x( static_cast< long long >( 0x8040201008040201 ) );
+         for( ; i + 32 <= count; i += 32 ) {
+            const __m256i v = _mm256_loadu_si256( reinterpret_cast< const __m256i* >( data + i ) );
+            const __m256i index = _mm256_and_si256( v, _mm256_set1_epi8( static_cast< char >( 0x8f ) ) );
+            const __m256i row = _mm256_or_si256( _mm256_shuffle_epi8( low, index ), _mm256_shuffle_epi8( high, _mm256_xor_si256( index, _mm256_set1_epi8( static_cast< char >( 0x80 ) ) ) ) );
+            const __m256i bit = _mm256_shuffle_epi8( bits, _mm256_and_si256( _mm256_srli_epi16( v, 4 ), _mm256_set1_epi8( 0x0f ) ) );
+            const auto mask = static_cast< unsigned >( _mm256_movemask_epi8( _mm256_cmpeq_epi8( _mm256_and_si256( row, bit ), bit ) ) );
+            if( mask != 0xffffffff ) {
+               return i + static_cast< std::size_t >( __builtin_ctz( ~mask ) );
+            }
+         }
+      }
+#endif
+      if( i + 16 <= count ) {
+         const __m128i low = _mm_loadu_si128( reinterpret_cast< const __m128i* >( cc.low ) );
+         const __m128i high = _mm_loadu_si128( reinterpret_cast< const __m128i* >( cc.high ) );
+         for( ; i + 16 <= count; i += 16 ) {
+            const auto mask = static_cast< unsigned >( _mm_movemask_epi8( scan_char_class_block( low, high, _mm_loadu_si128( reinterpret_cast< const __m128i* >( data + i ) ) ) ) );
+            if( mask != 0xffff ) {
+               return i + static_cast< std::size_t >( __builtin_ctz( ~mask ) );
+            }
+         }
+      }
+      return i + scan_char_class_scalar< Rule >( data + i, count - i );
+   }
+
+#else
+
+   template< typename Rule >
+   [[nodiscard]] std::size_t scan_char_class( const char* data, const std::size_t count ) noexcept
+   {
+      return scan_char_class_scalar< Rule >( data, count );
+   }
+
+#endif
+
+   // Consumes the longest run of bytes matched by Rule with a single bump and returns its length.
+
+   template< typename Rule, typename ParseInput >
+   std::size_t match_char_class( ParseInput& in )
+   {
+      std::size_t result = 0;
+      while( const std::size_t available = in.size( 1 ) ) {
+         const std::size_t count = scan_char_class< Rule >( in.current(), available );
+         if( count != 0 ) {
+            bump_help< Rule >( in, count );
+            result += count;
+         }
+         if( count < available ) {
+            break;
+         }
+      }
+      return result;
+   }
+
+}  // namespace tao::pegtl::internal
+
+#endif
@@ -0,0 +1,96 @@
+// Copyright (c) 2023 Dr. Colin Hirsch and Daniel Frey
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef TAO_PEGTL_INTERNAL_CUT_HPP
+#define TAO_PEGTL_INTERNAL_CUT_HPP
+
+#if !defined( __cpp_exceptions )
+#error "Exception support required for tao/pegtl/internal/cut.hpp"
+#else
+
+#include <type_traits>
+
+#include "enable_control.hpp"
+#include "must.hpp"
+#include "rewind_guard.hpp"
+#include "seq.hpp"
+
+#include "../apply_mode.hpp"
+#include "../rewind_mode.hpp"
+#include "../type_list.hpp"
+
+namespace tao::pegtl::internal
+{
+   // When no rewind guard is active the input can not go back to before the
+   // cut, wherefore inputs that count their guards can discard their buffer.
+
+   struct cut
+   {
+      using rule_t = cut;
+      using subs_t = empty_list;
+
+      template< typename ParseInput >
+      [[nodiscard]] static bool match( ParseInput& in ) noexcept
+      {
+         if constexpr( has_rewind_depth< ParseInput > ) {
+            if( in.rewind_depth() == 0 ) {
+               in.discard();
+            }
+         }
+         return true;
+      }
+   };
+
+   template<>
+   inline constexpr bool enable_control< cut > = false;
+
+   // A seq with a cut rewinds when a rule before the cut fails, it releases
+   // its rewind guard at the cut, and raises when a rule after the cut fails.
+   // The must<> is not called via the control since it is not a sub-rule.
+
+   template< typename Before, typename Cut, typename... After >
+   struct seq_commit;
+
+   template< typename... Before, typename Cut, typename... After >
+   struct seq_commit< type_list< Before... >, Cut, After... >
+   {
+      template< apply_mode A,
+                rewind_mode M,
+                template< typename... >
+                class Action,
+                template< typename... >
+                class Control,
+                typename ParseInput,
+                typename... States >
+      [[nodiscard]] static bool match( ParseInput& in, States&&... st )
+      {
+         {
+            auto m = in.template auto_rewind< M >();
+            using m_t = decltype( m );
+            if( !m( ( Control< Before >::template match< A, m_t::next_rewind_mode, Action, Control >( in, st... ) && ... ) ) ) {
+               return false;
+            }
+         }
+         (void)Control< Cut >::template match< A, rewind_mode::dontcare, Action, Control >( in, st... );
+         return ( must< After >::template match< A, rewind_mode::dontcare, Action, Control >( in, st... ) && ... );
+      }
+   };
+
+   template< typename Before, typename... Rules >
+   struct seq_split;
+
+   template< typename... Before, typename Rule, typename... Rules >
+   struct seq_split< type_list< Before... >, Rule, Rules... >
+      : std::conditional_t< is_cut< Rule >, seq_commit< type_list< Before... >, Rule, Rules... >, seq_split< type_list< Before..., Rule >, Rules... > >
+   {};
+
+   template< typename... Rules >
+   struct seq_cut
+      : seq_split< empty_list, Rules... >
+   {};
+
+}  // namespace tao::pegtl::internal
+
+#endif
+#endif
@@ -0,0 +1,67 @@
+// Copyright (c) 2023 Dr. Colin Hirsch and Daniel Frey
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef TAO_PEGTL_INTERNAL_FD_READER_HPP
+#define TAO_PEGTL_INTERNAL_FD_READER_HPP
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cassert>
+#include <cerrno>
+#include <cstddef>
+
+#if defined( __cpp_exceptions )
+#include <system_error>
+#else
+#include <cstdio>
+#include <exception>
+#endif
+
+namespace tao::pegtl::internal
+{
+   // Reads directly from a file descriptor into the buffer of a buffer_input<>,
+   // returning as soon as a single read() has transferred some data, which
+   // allows parsing data from pipes and sockets as soon as it arrives.
+
+   struct fd_reader
+   {
+      explicit fd_reader( const int fd ) noexcept
+         : m_fd( fd )
+      {
+         assert( m_fd >= 0 );
+#if defined( POSIX_FADV_SEQUENTIAL )
+         // Fails harmlessly with ESPIPE for pipes and sockets.
+         (void)::posix_fadvise( m_fd, 0, 0, POSIX_FADV_SEQUENTIAL );
+#endif
+      }
+
+      [[nodiscard]] std::size_t operator()( char* buffer, const std::size_t length ) const
+      {
+         while( true ) {
+            errno = 0;
+            const auto r = ::read( m_fd, buffer, length );
+            if( r >= 0 ) {
+               return static_cast< std::size_t >( r );
+            }
+            if( errno != EINTR ) {
+               break;
+            }
+         }
+         // LCOV_EXCL_START
+#if defined( __cpp_exceptions )
+         throw std::system_error( errno, std::system_category(), "read() failed" );
+#else
+         std::perror( "read() failed" );
+         std::terminate();
+#endif
+         // LCOV_EXCL_STOP
+      }
+
+      int m_fd;
+   };
+
+}  // namespace tao::pegtl::internal
+
+#endif
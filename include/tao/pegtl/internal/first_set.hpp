@@ -0,0 +1,231 @@
+// Copyright (c) 2023 Dr. Colin Hirsch and Daniel Frey
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef TAO_PEGTL_INTERNAL_FIRST_SET_HPP
+#define TAO_PEGTL_INTERNAL_FIRST_SET_HPP
+
+#include <cstddef>
+#include <type_traits>
+
+#include "any.hpp"
+#include "failure.hpp"
+#include "istring.hpp"
+#include "one.hpp"
+#include "opt.hpp"
+#include "peek_char.hpp"
+#include "plus.hpp"
+#include "range.hpp"
+#include "ranges.hpp"
+#include "result_on_found.hpp"
+#include "seq.hpp"
+#include "sor.hpp"
+#include "star.hpp"
+#include "string.hpp"
+#include "success.hpp"
+
+namespace tao::pegtl::internal
+{
+   // The set of bytes a rule can start with when it succeeds, together with whether
+   // it can succeed without consuming anything; rules that are not analysed, which
+   // includes all rules that can raise and all custom rules without a rule_t,
+   // conservatively get all bytes and empty.
+
+   struct first_set
+   {
+      bool bytes[ 256 ] = {};
+      bool empty = false;
+   };
+
+   [[nodiscard]] constexpr first_set first_set_all() noexcept
+   {
+      first_set r;
+      for( bool& b : r.bytes ) {
+         b = true;
+      }
+      r.empty = true;
+      return r;
+   }
+
+   template< typename Test >
+   [[nodiscard]] constexpr first_set first_set_test( const Test test ) noexcept
+   {
+      first_set r;
+      for( std::size_t i = 0; i < 256; ++i ) {
+         r.bytes[ i ] = test( static_cast< char >( static_cast< unsigned char >( i ) ) );
+      }
+      return r;
+   }
+
+   [[nodiscard]] constexpr first_set first_set_union( first_set l, const first_set& r ) noexcept
+   {
+      for( std::size_t i = 0; i < 256; ++i ) {
+         l.bytes[ i ] = l.bytes[ i ] || r.bytes[ i ];
+      }
+      l.empty = l.empty || r.empty;
+      return l;
+   }
+
+   // The first set of a seq of two rules of which the first can be empty.
+
+   [[nodiscard]] constexpr first_set first_set_then( first_set l, const first_set& r ) noexcept
+   {
+      l.empty = false;
+      return first_set_union( l, r );
+   }
+
+   template< typename Rule >
+   struct first_traits
+   {
+      [[nodiscard]] static constexpr first_set get() noexcept
+      {
+         return first_set_all();
+      }
+   };
+
+   template< typename Rule, typename = void >
+   inline constexpr bool first_has_rule_t = false;
+
+   template< typename Rule >
+   inline constexpr bool first_has_rule_t< Rule, std::void_t< typename Rule::rule_t > > = true;
+
+   template< typename Rule >
+   [[nodiscard]] constexpr first_set first_of() noexcept
+   {
+      if constexpr( first_has_rule_t< Rule > ) {
+         return first_traits< typename Rule::rule_t >::get();
+      }
+      else {
+         return first_set_all();
+      }
+   }
+
+   template<>
+   struct first_traits< success >
+   {
+      [[nodiscard]] static constexpr first_set get() noexcept
+      {
+         first_set r;
+         r.empty = true;
+         return r;
+      }
+   };
+
+   template<>
+   struct first_traits< failure >
+   {
+      [[nodiscard]] static constexpr first_set get() noexcept
+      {
+         return first_set();
+      }
+   };
+
+   template<>
+   struct first_traits< any< peek_char > >
+   {
+      [[nodiscard]] static constexpr first_set get() noexcept
+      {
+         return first_set_test( []( const char /*unused*/ ) { return true; } );
+      }
+   };
+
+   template< result_on_found R, char... Cs >
+   struct first_traits< one< R, peek_char, Cs... > >
+   {
+      [[nodiscard]] static constexpr first_set get() noexcept
+      {
+         return first_set_test( []( const char c ) { return one< R, peek_char, Cs... >::test_one( c ); } );
+      }
+   };
+
+   template< result_on_found R, char Lo, char Hi >
+   struct first_traits< range< R, peek_char, Lo, Hi > >
+   {
+      [[nodiscard]] static constexpr first_set get() noexcept
+      {
+         return first_set_test( []( const char c ) { return range< R, peek_char, Lo, Hi >::test_one( c ); } );
+      }
+   };
+
+   template< char... Cs >
+   struct first_traits< ranges< peek_char, Cs... > >
+   {
+      [[nodiscard]] static constexpr first_set get() noexcept
+      {
+         return first_set_test( []( const char c ) { return ranges< peek_char, Cs... >::test_one( c ); } );
+      }
+   };
+
+   template< char C, char... Cs >
+   struct first_traits< string< C, Cs... > >
+   {
+      [[nodiscard]] static constexpr first_set get() noexcept
+      {
+         return first_set_test( []( const char c ) { return c == C; } );
+      }
+   };
+
+   template< char C, char... Cs >
+   struct first_traits< istring< C, Cs... > >
+   {
+      [[nodiscard]] static constexpr first_set get() noexcept
+      {
+         return first_set_test( []( const char c ) { return ichar_equal< C >( c ); } );
+      }
+   };
+
+   template< typename Rule >
+   struct first_traits< opt< Rule > >
+   {
+      [[nodiscard]] static constexpr first_set get() noexcept
+      {
+         auto r = first_of< Rule >();
+         r.empty = true;
+         return r;
+      }
+   };
+
+   template< typename Rule >
+   struct first_traits< plus< Rule > >
+   {
+      [[nodiscard]] static constexpr first_set get() noexcept
+      {
+         return first_of< Rule >();
+      }
+   };
+
+   template< typename Rule >
+   struct first_traits< star< Rule > >
+      : first_traits< opt< Rule > >
+   {};
+
+   // Later rules of a seq are only considered as long as all previous ones can be empty,
+   // which keeps the analysis of recursive grammars from recursing, except for grammars
+   // with left recursion, which can not be parsed anyway.
+
+   template< typename... Rules >
+   struct first_traits< seq< Rules... > >
+   {
+      [[nodiscard]] static constexpr first_set get() noexcept
+      {
+         first_set r;
+         r.empty = true;
+         ( ( r.empty ? (void)( r = first_set_then( r, first_of< Rules >() ) ) : (void)0 ), ... );
+         return r;
+      }
+   };
+
+   template< typename... Rules >
+   struct first_traits< sor< Rules... > >
+   {
+      [[nodiscard]] static constexpr first_set get() noexcept
+      {
+         first_set r;
+         ( ( r = first_set_union( r, first_of< Rules >() ) ), ... );
+         return r;
+      }
+   };
+
+}  // namespace tao::pegtl::internal
+
+#endif
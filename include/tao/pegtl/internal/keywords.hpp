@@ -0,0 +1,200 @@
+// Copyright (c) 2023 Dr. Colin Hirsch and Daniel Frey
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef TAO_PEGTL_INTERNAL_KEYWORDS_HPP
+#define TAO_PEGTL_INTERNAL_KEYWORDS_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include "bump_help.hpp"
+#include "enable_control.hpp"
+#include "first_set.hpp"
+#include "identifier.hpp"
+#include "istring.hpp"
+#include "rewind_elision.hpp"
+#include "string.hpp"
+
+#include "../type_list.hpp"
+
+namespace tao::pegtl::internal
+{
+   template< typename String >
+   struct keyword_chars;
+
+   template< char... Cs >
+   struct keyword_chars< string< Cs... > >
+   {
+      static constexpr char value[] = { Cs... };
+   };
+
+   template< char... Cs >
+   struct keyword_chars< istring< Cs... > >
+   {
+      static constexpr char value[] = { Cs... };
+   };
+
+   template< bool Insensitive >
+   [[nodiscard]] constexpr char keyword_fold( const char c ) noexcept
+   {
+      if constexpr( Insensitive ) {
+         return ( ( 'A' <= c ) && ( c <= 'Z' ) ) ? static_cast< char >( c | 0x20 ) : c;
+      }
+      else {
+         return c;
+      }
+   }
+
+   // A trie with the nodes numbered in breadth-first order, wherefore the children of every
+   // node are consecutive; node 0 is the root, and the root's children are also indexed by byte.
+
+   template< std::size_t N >
+   struct keywords_trie
+   {
+      std::uint16_t root[ 256 ] = {};
+      std::uint16_t first[ N ] = {};
+      std::uint16_t count[ N ] = {};
+      char label[ N ] = {};
+      bool accept[ N ] = {};
+      std::size_t nodes = 0;
+      std::size_t longest = 0;
+   };
+
+   template< bool Insensitive, typename... Strings >
+   [[nodiscard]] constexpr auto keywords_build() noexcept
+   {
+      constexpr std::size_t words = sizeof...( Strings );
+      constexpr std::size_t sizes[] = { sizeof( keyword_chars< Strings >::value )... };
+      constexpr const char* chars[] = { keyword_chars< Strings >::value... };
+      constexpr std::size_t N = ( 1 + ... + sizeof( keyword_chars< Strings >::value ) );
+      static_assert( N < 65536, "too many keywords" );
+
+      std::size_t parent[ N ] = {};
+      char label[ N ] = {};
+      bool accept[ N ] = {};
+      std::size_t nodes = 1;
+      keywords_trie< N > t;
+
+      for( std::size_t w = 0; w < words; ++w ) {
+         std::size_t node = 0;
+         for( std::size_t i = 0; i < sizes[ w ]; ++i ) {
+            const char c = keyword_fold< Insensitive >( chars[ w ][ i ] );
+            std::size_t next = 0;
+            for( std::size_t m = 1; m < nodes; ++m ) {
+               if( ( parent[ m ] == node ) && ( label[ m ] == c ) ) {
+                  next = m;
+                  break;
+               }
+            }
+            if( next == 0 ) {
+               next = nodes++;
+               parent[ next ] = node;
+               label[ next ] = c;
+            }
+            node = next;
+         }
+         accept[ node ] = true;
+         t.longest = ( t.longest < sizes[ w ] ) ? sizes[ w ] : t.longest;
+      }
+      std::size_t order[ N ] = {};
+      std::size_t size = 1;
+      for( std::size_t i = 0; i < size; ++i ) {
+         const std::size_t n = order[ i ];
+         t.first[ i ] = static_cast< std::uint16_t >( size );
+         for( std::size_t m = 1; m < nodes; ++m ) {
+            if( parent[ m ] == n ) {
+               order[ size++ ] = m;
+            }
+         }
+         t.count[ i ] = static_cast< std::uint16_t >( size - t.first[ i ] );
+         t.label[ i ] = label[ n ];
+         t.accept[ i ] = accept[ n ];
+      }
+      t.nodes = size;
+      for( std::size_t i = t.first[ 0 ]; i < t.first[ 0 ] + t.count[ 0 ]; ++i ) {
+         t.root[ static_cast< unsigned char >( t.label[ i ] ) ] = static_cast< std::uint16_t >( i );
+      }
+      return t;
+   }
+
+   // Matches the longest of the Strings that is not followed by an identifier_other
+   // character, like a sor of keyword rules ordered from longest to shortest would.
+
+   template< bool Insensitive, typename... Strings >
+   struct keywords
+   {
+      using rule_t = keywords;
+      using subs_t = empty_list;
+
+      static_assert( sizeof...( Strings ) > 0 );
+
+      static constexpr auto trie = keywords_build< Insensitive, Strings... >();
+
+      [[nodiscard]] static constexpr bool test_any( const char c ) noexcept
+      {
+         const char f = keyword_fold< Insensitive >( c );
+         for( std::size_t i = 1; i < trie.nodes; ++i ) {
+            if( trie.label[ i ] == f ) {
+               return true;
+            }
+         }
+         return false;
+      }
+
+      template< typename ParseInput >
+      [[nodiscard]] static bool match( ParseInput& in ) noexcept( noexcept( in.size( 0 ) ) )
+      {
+         const std::size_t available = in.size( trie.longest + 1 );
+         if( available == 0 ) {
+            return false;
+         }
+         const char* p = in.current();
+         std::size_t result = 0;
+         std::size_t node = trie.root[ static_cast< unsigned char >( keyword_fold< Insensitive >( p[ 0 ] ) ) ];
+         for( std::size_t depth = 1; node != 0; ++depth ) {
+            if( trie.accept[ node ] && ( ( depth == available ) || ( !identifier_other::test_one( p[ depth ] ) ) ) ) {
+               result = depth;
+            }
+            if( depth == available ) {
+               break;
+            }
+            const char c = keyword_fold< Insensitive >( p[ depth ] );
+            const std::size_t b = trie.first[ node ];
+            const std::size_t e = b + trie.count[ node ];
+            node = 0;
+            for( std::size_t i = b; i < e; ++i ) {
+               if( trie.label[ i ] == c ) {
+                  node = i;
+                  break;
+               }
+            }
+         }
+         if( result != 0 ) {
+            bump_help< keywords >( in, result );
+            return true;
+         }
+         return false;
+      }
+   };
+
+   template< bool Insensitive, typename... Strings >
+   inline constexpr bool enable_control< keywords< Insensitive, Strings... > > = false;
+
+   template< bool Insensitive, typename... Strings >
+   struct consume_traits< keywords< Insensitive, Strings... > >
+      : consume_leaf_traits< true, true >
+   {};
+
+   template< bool Insensitive, typename... Strings >
+   struct first_traits< keywords< Insensitive, Strings... > >
+   {
+      [[nodiscard]] static constexpr first_set get() noexcept
+      {
+         return first_set_test( []( const char c ) { return keywords< Insensitive, Strings... >::trie.root[ static_cast< unsigned char >( keyword_fold< Insensitive >( c ) ) ] != 0; } );
+      }
+   };
+
+}  // namespace tao::pegtl::internal
+
+#endif
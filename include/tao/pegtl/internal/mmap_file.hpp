@@ -16,6 +16,8 @@
 #else
 #endif
 
+#include "../mmap_options.hpp"
+
 #include "filesystem.hpp"
 
 namespace tao::pegtl::internal
@@ -24,8 +26,8 @@ namespace tao::pegtl::internal
    {
       const mmap_file_impl data;
 
-      explicit mmap_file( const internal::filesystem::path& path )
-         : data( path )
+      explicit mmap_file( const internal::filesystem::path& path, const mmap_options& options = mmap_options() )
+         : data( path, options )
       {}
 
       mmap_file( const mmap_file& ) = delete;
@@ -18,6 +18,8 @@
 
 #include <utility>
 
+#include "../mmap_options.hpp"
+
 #include "filesystem.hpp"
 
 namespace tao::pegtl::internal
@@ -87,13 +89,13 @@ namespace tao::pegtl::internal
    class mmap_file_posix
    {
    public:
-      explicit mmap_file_posix( const internal::filesystem::path& path )
-         : mmap_file_posix( mmap_file_open( path ) )
+      explicit mmap_file_posix( const internal::filesystem::path& path, const mmap_options& options = mmap_options() )
+         : mmap_file_posix( mmap_file_open( path ), options )
       {}
 
-      explicit mmap_file_posix( const mmap_file_open& reader )
+      explicit mmap_file_posix( const mmap_file_open& reader, const mmap_options& options = mmap_options() )
          : m_size( reader.size() ),
-           m_data( static_cast< const char* >( ::mmap( nullptr, m_size, PROT_READ, MAP_PRIVATE, reader.m_fd, 0 ) ) )
+           m_data( static_cast< const char* >( ::mmap( nullptr, m_size, PROT_READ, flags( options ), reader.m_fd, 0 ) ) )
       {
          if( ( m_size != 0 ) && ( reinterpret_cast< intptr_t >( m_data ) == -1 ) ) {
             // LCOV_EXCL_START
@@ -106,6 +108,9 @@ namespace tao::pegtl::internal
 #endif
             // LCOV_EXCL_STOP
          }
+         if( m_size != 0 ) {
+            advise( options );
+         }
       }
 
       mmap_file_posix( const mmap_file_posix& ) = delete;
@@ -149,6 +154,39 @@ namespace tao::pegtl::internal
       }
 
    private:
+      [[nodiscard]] static int flags( [[maybe_unused]] const mmap_options& options ) noexcept
+      {
+#if defined( MAP_POPULATE )
+         if( options.populate ) {
+            return MAP_PRIVATE | MAP_POPULATE;
+         }
+#endif
+         return MAP_PRIVATE;
+      }
+
+      // The advice is only a hint, failures are not errors.
+
+      void advise( [[maybe_unused]] const mmap_options& options ) const noexcept
+      {
+         // Legacy C interface requires pointer-to-mutable but does not write through the pointer.
+         [[maybe_unused]] void* addr = const_cast< char* >( m_data );
+#if defined( MADV_HUGEPAGE )
+         if( options.hugepage ) {
+            (void)::madvise( addr, m_size, MADV_HUGEPAGE );
+         }
+#endif
+#if defined( MADV_SEQUENTIAL )
+         if( options.sequential ) {
+            (void)::madvise( addr, m_size, MADV_SEQUENTIAL );
+         }
+#endif
+#if defined( MADV_WILLNEED )
+         if( options.willneed ) {
+            (void)::madvise( addr, m_size, MADV_WILLNEED );
+         }
+#endif
+      }
+
       const std::size_t m_size;
       const char* const m_data;
    };
@@ -32,6 +32,8 @@
 #include <exception>
 #endif
 
+#include "../mmap_options.hpp"
+
 #include "filesystem.hpp"
 
 namespace tao::pegtl::internal
@@ -170,7 +172,9 @@ namespace tao::pegtl::internal
    class mmap_file_win32
    {
    public:
-      explicit mmap_file_win32( const internal::filesystem::path& path )
+      // The mmap_options are not supported on Windows and ignored.
+
+      explicit mmap_file_win32( const internal::filesystem::path& path, const mmap_options& /*unused*/ = mmap_options() )
          : mmap_file_win32( mmap_file_mmap( path ) )
       {}
 
@@ -0,0 +1,163 @@
+// Copyright (c) 2023 Dr. Colin Hirsch and Daniel Frey
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef TAO_PEGTL_INTERNAL_MMAP_WINDOW_HPP
+#define TAO_PEGTL_INTERNAL_MMAP_WINDOW_HPP
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+
+#if !defined( __cpp_exceptions )
+#include <cstdio>
+#include <exception>
+#endif
+
+#include "filesystem.hpp"
+#include "mmap_file_posix.hpp"
+
+namespace tao::pegtl::internal
+{
+   // Maps a window of at most length() bytes of a file, starting at a page
+   // aligned offset(), that can be moved forward through the file with map().
+   // The length is one page more than the minimum rounded up to whole pages,
+   // so that at least minimum bytes from any mapped offset are always mapped.
+
+   class mmap_window
+   {
+   public:
+      mmap_window( const internal::filesystem::path& path, const std::size_t minimum )
+         : m_file( path ),
+           m_size( m_file.size() ),
+           m_page( static_cast< std::size_t >( ::sysconf( _SC_PAGESIZE ) ) ),
+           m_length( ( ( minimum + m_page - 1 ) / m_page ) * m_page + m_page )
+      {
+         if( !map( 0 ) ) {
+            // LCOV_EXCL_START
+#if defined( __cpp_exceptions )
+            const internal::error_code ec( errno, internal::system_category() );
+            throw internal::filesystem::filesystem_error( "mmap() failed", m_file.m_path, ec );
+#else
+            std::perror( "mmap() failed" );
+            std::terminate();
+#endif
+            // LCOV_EXCL_STOP
+         }
+      }
+
+      mmap_window( const mmap_window& ) = delete;
+      mmap_window( mmap_window&& ) = delete;
+
+      ~mmap_window()
+      {
+         unmap();
+      }
+
+      mmap_window& operator=( const mmap_window& ) = delete;
+      mmap_window& operator=( mmap_window&& ) = delete;
+
+      [[nodiscard]] std::size_t file_size() const noexcept
+      {
+         return m_size;
+      }
+
+      [[nodiscard]] std::size_t page_size() const noexcept
+      {
+         return m_page;
+      }
+
+      [[nodiscard]] std::size_t offset() const noexcept
+      {
+         return m_offset;
+      }
+
+      [[nodiscard]] std::size_t length() const noexcept
+      {
+         return m_length;
+      }
+
+      [[nodiscard]] const char* begin() const noexcept
+      {
+         return m_data;
+      }
+
+      [[nodiscard]] const char* end() const noexcept
+      {
+         return m_data + m_mapped;
+      }
+
+      [[nodiscard]] bool at_eof() const noexcept
+      {
+         return m_offset + m_mapped == m_size;
+      }
+
+      // Replaces the current mapping with one starting at the page containing the given file offset;
+      // when the new mapping can not be created the current one is kept and false is returned.
+
+      [[nodiscard]] bool map( const std::size_t offset ) noexcept
+      {
+         const std::size_t aligned = offset - ( offset % m_page );
+         const std::size_t mapped = ( std::min )( m_length, m_size - aligned );
+         const char* data = nullptr;
+         if( mapped != 0 ) {
+            void* p = ::mmap( nullptr, mapped, PROT_READ, MAP_PRIVATE, m_file.m_fd, static_cast< off_t >( aligned ) );
+            if( p == MAP_FAILED ) {
+               return false;  // LCOV_EXCL_LINE
+            }
+#if defined( MADV_SEQUENTIAL )
+            (void)::madvise( p, mapped, MADV_SEQUENTIAL );
+#endif
+#if defined( MADV_WILLNEED )
+            (void)::madvise( p, mapped, MADV_WILLNEED );
+#endif
+            data = static_cast< const char* >( p );
+         }
+         unmap();
+         m_offset = aligned;
+         m_mapped = mapped;
+         m_data = data;
+         m_released = data;
+         return true;
+      }
+
+      // Drops the pages wholly before the given pointer from the resident set; the advice is only a hint.
+
+      void release( const char* until ) noexcept
+      {
+         const auto* const limit = m_data + ( ( static_cast< std::size_t >( until - m_data ) / m_page ) * m_page );
+         if( limit > m_released ) {
+#if defined( MADV_DONTNEED )
+            // Legacy C interface requires pointer-to-mutable but does not write through the pointer.
+            (void)::madvise( const_cast< char* >( m_released ), static_cast< std::size_t >( limit - m_released ), MADV_DONTNEED );
+#endif
+            m_released = limit;
+         }
+      }
+
+   private:
+      void unmap() noexcept
+      {
+         if( m_mapped != 0 ) {
+            // Legacy C interface requires pointer-to-mutable but does not write through the pointer.
+            ::munmap( const_cast< char* >( m_data ), m_mapped );
+         }
+      }
+
+      const mmap_file_open m_file;
+      const std::size_t m_size;
+      const std::size_t m_page;
+      const std::size_t m_length;
+
+      std::size_t m_offset = 0;
+      std::size_t m_mapped = 0;
+      const char* m_data = nullptr;
+      const char* m_released = nullptr;
+   };
+
+}  // namespace tao::pegtl::internal
+
+#endif
@@ -9,6 +9,7 @@
 
 #include "any.hpp"
 #include "bump_help.hpp"
+#include "char_class.hpp"
 #include "enable_control.hpp"
 #include "failure.hpp"
 #include "result_on_found.hpp"
@@ -26,11 +27,21 @@ namespace tao::pegtl::internal
       using rule_t = one;
       using subs_t = empty_list;
 
-      [[nodiscard]] static constexpr bool test_one( const data_t c ) noexcept
+      [[nodiscard]] static constexpr bool test_compare( const data_t c ) noexcept
       {
          return ( ( c == Cs ) || ... ) == static_cast< bool >( R );
       }
 
+      [[nodiscard]] static constexpr bool test_one( const data_t c ) noexcept
+      {
+         if constexpr( char_class_peek< Peek > && ( sizeof...( Cs ) > 3 ) ) {
+            return char_class_v< one >.test( static_cast< unsigned char >( c ) );
+         }
+         else {
+            return test_compare( c );
+         }
+      }
+
       [[nodiscard]] static constexpr bool test_any( const data_t c ) noexcept
       {
          return test_one( c );
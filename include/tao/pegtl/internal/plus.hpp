@@ -7,6 +7,7 @@
 
 #include <type_traits>
 
+#include "char_class.hpp"
 #include "enable_control.hpp"
 #include "seq.hpp"
 
@@ -42,7 +43,10 @@ namespace tao::pegtl::internal
                 typename... States >
       [[nodiscard]] static bool match( ParseInput& in, States&&... st )
       {
-         if( Control< Rule >::template match< A, M, Action, Control >( in, st... ) ) {
+         if constexpr( char_class_scan< Rule, A, Action, Control > ) {
+            return match_char_class< Rule >( in ) != 0;
+         }
+         else if( Control< Rule >::template match< A, M, Action, Control >( in, st... ) ) {
             while( Control< Rule >::template match< A, rewind_mode::required, Action, Control >( in, st... ) ) {
             }
             return true;
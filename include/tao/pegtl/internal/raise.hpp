@@ -33,9 +33,10 @@ namespace tao::pegtl::internal
                 class Control,
                 typename ParseInput,
                 typename... States >
-      [[noreturn]] static bool match( ParseInput& in, States&&... st )
+      [[nodiscard]] static bool match( ParseInput& in, States&&... st )
       {
          Control< T >::raise( static_cast< const ParseInput& >( in ), st... );
+         return false;
       }
    };
 
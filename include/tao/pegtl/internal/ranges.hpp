@@ -8,6 +8,7 @@
 #include <utility>
 
 #include "bump_help.hpp"
+#include "char_class.hpp"
 #include "enable_control.hpp"
 #include "failure.hpp"
 #include "one.hpp"
@@ -45,14 +46,24 @@ namespace tao::pegtl::internal
          }
       }
 
-      [[nodiscard]] static constexpr bool test_one( const data_t c ) noexcept
+      [[nodiscard]] static constexpr bool test_compare( const data_t c ) noexcept
       {
          return test_impl( std::make_index_sequence< sizeof...( Cs ) / 2 >(), c );
       }
 
+      [[nodiscard]] static constexpr bool test_one( const data_t c ) noexcept
+      {
+         if constexpr( char_class_peek< Peek > && ( sizeof...( Cs ) > 3 ) ) {
+            return char_class_v< ranges >.test( static_cast< unsigned char >( c ) );
+         }
+         else {
+            return test_compare( c );
+         }
+      }
+
       [[nodiscard]] static constexpr bool test_any( const data_t c ) noexcept
       {
-         return test_impl( std::make_index_sequence< sizeof...( Cs ) / 2 >(), c );
+         return test_one( c );
       }
 
       template< typename ParseInput >
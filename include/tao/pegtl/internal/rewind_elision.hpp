@@ -0,0 +1,250 @@
+// Copyright (c) 2023 Dr. Colin Hirsch and Daniel Frey
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef TAO_PEGTL_INTERNAL_REWIND_ELISION_HPP
+#define TAO_PEGTL_INTERNAL_REWIND_ELISION_HPP
+
+#include <type_traits>
+
+#include "any.hpp"
+#include "at.hpp"
+#include "bof.hpp"
+#include "bol.hpp"
+#include "bytes.hpp"
+#include "eof.hpp"
+#include "failure.hpp"
+#include "istring.hpp"
+#include "not_at.hpp"
+#include "one.hpp"
+#include "opt.hpp"
+#include "plus.hpp"
+#include "range.hpp"
+#include "ranges.hpp"
+#include "rep.hpp"
+#include "result_on_found.hpp"
+#include "seq.hpp"
+#include "sor.hpp"
+#include "star.hpp"
+#include "string.hpp"
+#include "success.hpp"
+#include "unobserved.hpp"
+
+#include "../apply_mode.hpp"
+#include "../rewind_mode.hpp"
+
+namespace tao::pegtl::internal
+{
+   // Whether a rule can fail, whether it can consume input on success, and whether it
+   // can fail after consuming input when called without a rewind_mode::required, i.e.
+   // whether it relies on its own rewind guard; rules that are not analysed, including
+   // custom rules without rule_t, get true.
+   // The consumption on success and failure of rules with actions or a control other
+   // than normal is not affected by the latter, but they can always fail.
+
+   struct consume_info
+   {
+      bool fails = true;
+      bool consumes = true;
+      bool partial = true;
+   };
+
+   template< typename Rule >
+   struct consume_traits
+   {
+      template< apply_mode, template< typename... > class, template< typename... > class, unsigned >
+      [[nodiscard]] static constexpr consume_info get() noexcept
+      {
+         return consume_info();
+      }
+   };
+
+   template< typename Rule, typename = void >
+   inline constexpr bool consume_analysed = false;
+
+   template< typename Rule >
+   inline constexpr bool consume_analysed< Rule, std::void_t< typename Rule::rule_t > > = true;
+
+   // The depth limit stops the analysis of recursive grammars; the results are stored
+   // in a variable template so that each is only computed once.
+
+   inline constexpr unsigned consume_depth_limit = 8;
+
+   template< typename Rule, apply_mode A, template< typename... > class Action, template< typename... > class Control, unsigned Depth = 0 >
+   [[nodiscard]] constexpr consume_info consume_of() noexcept
+   {
+      if constexpr( consume_analysed< Rule > && ( Depth < consume_depth_limit ) ) {
+         consume_info r = consume_traits< typename Rule::rule_t >::template get< A, Action, Control, Depth >();
+         r.fails = r.fails || !unobserved< Rule, A, Action, Control >;
+         return r;
+      }
+      else {
+         return consume_info();
+      }
+   }
+
+   template< typename Rule, apply_mode A, template< typename... > class Action, template< typename... > class Control, unsigned Depth = 0 >
+   inline constexpr consume_info consume_v = consume_of< Rule, A, Action, Control, Depth >();
+
+   // A rule that is called with rewind_mode::required but can not fail after consuming
+   // input does not need to create a rewind guard and is called with dontcare instead.
+
+   template< typename Rule, apply_mode A, rewind_mode M, template< typename... > class Action, template< typename... > class Control >
+   inline constexpr rewind_mode rewind_elision = ( ( M == rewind_mode::required ) && !consume_v< Rule, A, Action, Control >.partial ) ? rewind_mode::dontcare : M;
+
+   template< bool Fails, bool Consumes >
+   struct consume_leaf_traits
+   {
+      template< apply_mode, template< typename... > class, template< typename... > class, unsigned >
+      [[nodiscard]] static constexpr consume_info get() noexcept
+      {
+         return { Fails, Consumes, false };
+      }
+   };
+
+   template<>
+   struct consume_traits< success >
+      : consume_leaf_traits< false, false >
+   {};
+
+   template<>
+   struct consume_traits< failure >
+      : consume_leaf_traits< true, false >
+   {};
+
+   template<>
+   struct consume_traits< bof >
+      : consume_leaf_traits< true, false >
+   {};
+
+   template<>
+   struct consume_traits< bol >
+      : consume_leaf_traits< true, false >
+   {};
+
+   template<>
+   struct consume_traits< eof >
+      : consume_leaf_traits< true, false >
+   {};
+
+   template< typename... Rules >
+   struct consume_traits< at< Rules... > >
+      : consume_leaf_traits< true, false >
+   {};
+
+   template< typename... Rules >
+   struct consume_traits< not_at< Rules... > >
+      : consume_leaf_traits< true, false >
+   {};
+
+   template< typename Peek >
+   struct consume_traits< any< Peek > >
+      : consume_leaf_traits< true, true >
+   {};
+
+   template< unsigned Cnt >
+   struct consume_traits< bytes< Cnt > >
+      : consume_leaf_traits< true, true >
+   {};
+
+   template< result_on_found R, typename Peek, typename Peek::data_t... Cs >
+   struct consume_traits< one< R, Peek, Cs... > >
+      : consume_leaf_traits< true, true >
+   {};
+
+   template< result_on_found R, typename Peek, typename Peek::data_t Lo, typename Peek::data_t Hi >
+   struct consume_traits< range< R, Peek, Lo, Hi > >
+      : consume_leaf_traits< true, true >
+   {};
+
+   template< typename Peek, typename Peek::data_t... Cs >
+   struct consume_traits< ranges< Peek, Cs... > >
+      : consume_leaf_traits< true, true >
+   {};
+
+   template< char... Cs >
+   struct consume_traits< string< Cs... > >
+      : consume_leaf_traits< true, true >
+   {};
+
+   template< char... Cs >
+   struct consume_traits< istring< Cs... > >
+      : consume_leaf_traits< true, true >
+   {};
+
+   template< typename Rule >
+   struct consume_traits< opt< Rule > >
+   {
+      template< apply_mode A, template< typename... > class Action, template< typename... > class Control, unsigned Depth >
+      [[nodiscard]] static constexpr consume_info get() noexcept
+      {
+         return { false, consume_v< Rule, A, Action, Control, Depth + 1 >.consumes, false };
+      }
+   };
+
+   template< typename Rule >
+   struct consume_traits< star< Rule > >
+      : consume_traits< opt< Rule > >
+   {};
+
+   template< typename Rule >
+   struct consume_traits< plus< Rule > >
+   {
+      template< apply_mode A, template< typename... > class Action, template< typename... > class Control, unsigned Depth >
+      [[nodiscard]] static constexpr consume_info get() noexcept
+      {
+         return consume_v< Rule, A, Action, Control, Depth + 1 >;
+      }
+   };
+
+   template< unsigned Cnt, typename Rule >
+   struct consume_traits< rep< Cnt, Rule > >
+   {
+      template< apply_mode A, template< typename... > class Action, template< typename... > class Control, unsigned Depth >
+      [[nodiscard]] static constexpr consume_info get() noexcept
+      {
+         consume_info r = consume_v< Rule, A, Action, Control, Depth + 1 >;
+         r.partial = r.partial || ( ( Cnt > 1 ) && r.consumes && r.fails );
+         return r;
+      }
+   };
+
+   template< typename... Rules >
+   struct consume_traits< seq< Rules... > >
+   {
+      template< apply_mode A, template< typename... > class Action, template< typename... > class Control, unsigned Depth >
+      [[nodiscard]] static constexpr consume_info get() noexcept
+      {
+         consume_info r = { false, false, false };
+         const consume_info s[] = { consume_v< Rules, A, Action, Control, Depth + 1 >... };
+         for( const consume_info& i : s ) {
+            r.partial = r.partial || i.partial || ( r.consumes && i.fails );
+            r.fails = r.fails || i.fails;
+            r.consumes = r.consumes || i.consumes;
+         }
+         return r;
+      }
+   };
+
+   // All but the last rule of a sor are called with rewind_mode::required.
+
+   template< typename... Rules >
+   struct consume_traits< sor< Rules... > >
+   {
+      template< apply_mode A, template< typename... > class Action, template< typename... > class Control, unsigned Depth >
+      [[nodiscard]] static constexpr consume_info get() noexcept
+      {
+         consume_info r = { true, false, false };
+         const consume_info s[] = { consume_v< Rules, A, Action, Control, Depth + 1 >... };
+         for( const consume_info& i : s ) {
+            r.partial = i.partial;
+            r.fails = r.fails && i.fails;
+            r.consumes = r.consumes || i.consumes;
+         }
+         return r;
+      }
+   };
+
+}  // namespace tao::pegtl::internal
+
+#endif
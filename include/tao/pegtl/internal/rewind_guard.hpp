@@ -12,6 +12,16 @@
 
 namespace tao::pegtl::internal
 {
+   // Inputs with rewind_enter() and rewind_leave() are told about every guard that can
+   // rewind them, which lets them know when nothing can go back to before the current
+   // position, see the cut rule.
+
+   template< typename ParseInput, typename = void >
+   inline constexpr bool has_rewind_depth = false;
+
+   template< typename ParseInput >
+   inline constexpr bool has_rewind_depth< ParseInput, decltype( std::declval< ParseInput& >().rewind_enter() ) > = true;
+
    template< rewind_mode M, typename ParseInput >
    class [[nodiscard]] rewind_guard
    {
@@ -46,7 +56,11 @@ namespace tao::pegtl::internal
       explicit rewind_guard( ParseInput* in ) noexcept
          : m_input( in ),
            m_saved( in->rewind_save() )
-      {}
+      {
+         if constexpr( has_rewind_depth< ParseInput > ) {
+            in->rewind_enter();
+         }
+      }
 
       rewind_guard( const rewind_guard& ) = delete;
       rewind_guard( rewind_guard&& ) = delete;
@@ -55,6 +69,9 @@ namespace tao::pegtl::internal
       {
          if( m_input != nullptr ) {
             m_input->rewind_restore( std::move( m_saved ) );
+            if constexpr( has_rewind_depth< ParseInput > ) {
+               m_input->rewind_leave();
+            }
          }
       }
 
@@ -64,6 +81,9 @@ namespace tao::pegtl::internal
       [[nodiscard]] bool operator()( const bool result ) noexcept
       {
          if( result ) {
+            if constexpr( has_rewind_depth< ParseInput > ) {
+               m_input->rewind_leave();
+            }
             m_input = nullptr;
             return true;
          }
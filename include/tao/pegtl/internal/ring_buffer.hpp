@@ -0,0 +1,135 @@
+// Copyright (c) 2023 Dr. Colin Hirsch and Daniel Frey
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef TAO_PEGTL_INTERNAL_RING_BUFFER_HPP
+#define TAO_PEGTL_INTERNAL_RING_BUFFER_HPP
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstddef>
+
+#if defined( __cpp_exceptions )
+#include <system_error>
+#else
+#include <cstdio>
+#include <exception>
+#endif
+
+#if !defined( __linux__ )
+#include <cstdio>
+#endif
+
+namespace tao::pegtl::internal
+{
+   // A ring buffer whose memory is mapped twice, back-to-back, into the
+   // address space, so that any range of up to size() bytes starting
+   // within the first mapping is contiguous even when it wraps around.
+
+   class ring_buffer
+   {
+   public:
+      explicit ring_buffer( const std::size_t minimum )
+         : m_size( round_up( minimum ) ),
+           m_data( map( m_size ) )
+      {}
+
+      ring_buffer( const ring_buffer& ) = delete;
+      ring_buffer( ring_buffer&& ) = delete;
+
+      ~ring_buffer()
+      {
+         ::munmap( m_data, 2 * m_size );
+      }
+
+      ring_buffer& operator=( const ring_buffer& ) = delete;
+      ring_buffer& operator=( ring_buffer&& ) = delete;
+
+      [[nodiscard]] std::size_t size() const noexcept
+      {
+         return m_size;
+      }
+
+      [[nodiscard]] char* data() const noexcept
+      {
+         return m_data;
+      }
+
+   private:
+      [[nodiscard]] static std::size_t round_up( const std::size_t minimum ) noexcept
+      {
+         const auto page = static_cast< std::size_t >( ::sysconf( _SC_PAGESIZE ) );
+         return ( ( minimum + page - 1 ) / page ) * page;
+      }
+
+      [[noreturn]] static void fail( const char* what, const int fd = -1 )
+      {
+         // LCOV_EXCL_START
+         const int ec = errno;
+         if( fd >= 0 ) {
+            ::close( fd );
+         }
+#if defined( __cpp_exceptions )
+         throw std::system_error( ec, std::system_category(), what );
+#else
+         errno = ec;
+         std::perror( what );
+         std::terminate();
+#endif
+         // LCOV_EXCL_STOP
+      }
+
+      [[nodiscard]] static int open()
+      {
+         errno = 0;
+#if defined( __linux__ )
+         const int fd = ::memfd_create( "tao-pegtl-ring-buffer", MFD_CLOEXEC );
+#else
+         char name[ 64 ];
+         std::snprintf( name, sizeof( name ), "/tao-pegtl-%ld-%p", static_cast< long >( ::getpid() ), static_cast< void* >( &name ) );
+         const int fd = ::shm_open( name, O_RDWR | O_CREAT | O_EXCL, 0600 );
+         if( fd >= 0 ) {
+            ::shm_unlink( name );
+         }
+#endif
+         if( fd < 0 ) {
+            fail( "creating ring buffer file failed" );  // LCOV_EXCL_LINE
+         }
+         return fd;
+      }
+
+      [[nodiscard]] static char* map( const std::size_t size )
+      {
+         const int fd = open();
+         if( ::ftruncate( fd, static_cast< off_t >( size ) ) != 0 ) {
+            fail( "ftruncate() failed", fd );  // LCOV_EXCL_LINE
+         }
+         void* base = ::mmap( nullptr, 2 * size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0 );
+         if( base == MAP_FAILED ) {
+            fail( "mmap() failed", fd );  // LCOV_EXCL_LINE
+         }
+         auto* data = static_cast< char* >( base );
+         if( ( ::mmap( data, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0 ) == MAP_FAILED ) || ( ::mmap( data + size, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0 ) == MAP_FAILED ) ) {
+            // LCOV_EXCL_START
+            const int ec = errno;
+            ::munmap( base, 2 * size );
+            errno = ec;
+            fail( "mmap() failed", fd );
+            // LCOV_EXCL_STOP
+         }
+         ::close( fd );
+         return data;
+      }
+
+      const std::size_t m_size;
+      char* const m_data;
+   };
+
+}  // namespace tao::pegtl::internal
+
+#endif
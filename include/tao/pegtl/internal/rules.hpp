@@ -27,6 +27,7 @@
 #include "if_apply.hpp"
 #include "if_then_else.hpp"
 #include "istring.hpp"
+#include "keywords.hpp"
 #include "list.hpp"
 #include "list_tail.hpp"
 #include "list_tail_pad.hpp"
@@ -47,6 +48,7 @@
 #include "require.hpp"
 #include "seq.hpp"
 #include "sor.hpp"
+#include "sor_dispatch.hpp"
 #include "star.hpp"
 #include "state.hpp"
 #include "string.hpp"
@@ -54,6 +56,7 @@
 #include "until.hpp"
 
 #if defined( __cpp_exceptions )
+#include "cut.hpp"
 #include "if_must.hpp"
 #include "if_must_else.hpp"
 #include "list_must.hpp"
@@ -5,6 +5,8 @@
 #ifndef TAO_PEGTL_INTERNAL_SEQ_HPP
 #define TAO_PEGTL_INTERNAL_SEQ_HPP
 
+#include <type_traits>
+
 #include "enable_control.hpp"
 #include "success.hpp"
 
@@ -17,6 +19,16 @@ namespace tao::pegtl::internal
    template< typename... Rules >
    struct seq;
 
+   // A seq with a cut is implemented in cut.hpp.
+
+   struct cut;
+
+   template< typename... Rules >
+   struct seq_cut;
+
+   template< typename Rule >
+   inline constexpr bool is_cut = std::is_base_of_v< cut, Rule >;
+
    template<>
    struct seq<>
       : success
@@ -41,6 +53,9 @@ namespace tao::pegtl::internal
          if constexpr( sizeof...( Rules ) == 1 ) {
             return Control< Rules... >::template match< A, M, Action, Control >( in, st... );
          }
+         else if constexpr( ( is_cut< Rules > || ... ) ) {
+            return seq_cut< Rules... >::template match< A, M, Action, Control >( in, st... );
+         }
          else {
             auto m = in.template auto_rewind< M >();
             using m_t = decltype( m );
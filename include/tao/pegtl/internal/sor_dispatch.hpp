@@ -0,0 +1,116 @@
+// Copyright (c) 2023 Dr. Colin Hirsch and Daniel Frey
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef TAO_PEGTL_INTERNAL_SOR_DISPATCH_HPP
+#define TAO_PEGTL_INTERNAL_SOR_DISPATCH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include "enable_control.hpp"
+#include "failure.hpp"
+#include "first_set.hpp"
+#include "rewind_elision.hpp"
+#include "sor.hpp"
+
+#include "../apply_mode.hpp"
+#include "../rewind_mode.hpp"
+#include "../type_list.hpp"
+
+namespace tao::pegtl::internal
+{
+   // For every byte, and for the end of the input at index 256, the bit mask of
+   // the rules whose first set says that they might succeed at that point.
+
+   struct sor_dispatch_table
+   {
+      std::uint64_t masks[ 257 ] = {};
+   };
+
+   template< typename... Rules >
+   [[nodiscard]] constexpr sor_dispatch_table sor_dispatch_make() noexcept
+   {
+      sor_dispatch_table t;
+      const first_set sets[] = { first_of< Rules >()... };
+      for( std::size_t r = 0; r < sizeof...( Rules ); ++r ) {
+         for( std::size_t i = 0; i < 256; ++i ) {
+            if( sets[ r ].bytes[ i ] || sets[ r ].empty ) {
+               t.masks[ i ] |= std::uint64_t( 1 ) << r;
+            }
+         }
+         if( sets[ r ].empty ) {
+            t.masks[ 256 ] |= std::uint64_t( 1 ) << r;
+         }
+      }
+      return t;
+   }
+
+   template< typename... Rules >
+   inline constexpr sor_dispatch_table sor_dispatch_table_v = sor_dispatch_make< Rules... >();
+
+   template< typename... Rules >
+   struct sor_dispatch;
+
+   template<>
+   struct sor_dispatch<>
+      : failure
+   {};
+
+   template< typename... Rules >
+   struct sor_dispatch
+   {
+      using rule_t = sor_dispatch;
+      using subs_t = type_list< Rules... >;
+
+      template< apply_mode A,
+                rewind_mode M,
+                template< typename... >
+                class Action,
+                template< typename... >
+                class Control,
+                std::size_t... Indices,
+                typename ParseInput,
+                typename... States >
+      [[nodiscard]] static bool match( std::index_sequence< Indices... > /*unused*/, ParseInput& in, States&&... st )
+      {
+         const std::uint64_t mask = sor_dispatch_table_v< Rules... >.masks[ in.empty() ? 256 : in.peek_uint8() ];
+         return ( ( ( ( mask >> Indices ) & 1 ) && Control< Rules >::template match< A, ( ( Indices == ( sizeof...( Rules ) - 1 ) ) ? M : rewind_mode::required ), Action, Control >( in, st... ) ) || ... );
+      }
+
+      template< apply_mode A,
+                rewind_mode M,
+                template< typename... >
+                class Action,
+                template< typename... >
+                class Control,
+                typename ParseInput,
+                typename... States >
+      [[nodiscard]] static bool match( ParseInput& in, States&&... st )
+      {
+         if constexpr( sizeof...( Rules ) <= 64 ) {
+            return match< A, M, Action, Control >( std::index_sequence_for< Rules... >(), in, st... );
+         }
+         else {
+            return sor< Rules... >::template match< A, M, Action, Control >( in, st... );
+         }
+      }
+   };
+
+   template< typename... Rules >
+   inline constexpr bool enable_control< sor_dispatch< Rules... > > = false;
+
+   template< typename... Rules >
+   struct consume_traits< sor_dispatch< Rules... > >
+      : consume_traits< sor< Rules... > >
+   {};
+
+   template< typename... Rules >
+   struct first_traits< sor_dispatch< Rules... > >
+      : first_traits< sor< Rules... > >
+   {};
+
+}  // namespace tao::pegtl::internal
+
+#endif
@@ -7,6 +7,7 @@
 
 #include <type_traits>
 
+#include "char_class.hpp"
 #include "enable_control.hpp"
 #include "seq.hpp"
 
@@ -37,7 +38,12 @@ namespace tao::pegtl::internal
                 typename... States >
       [[nodiscard]] static bool match( ParseInput& in, States&&... st )
       {
-         while( Control< Rule >::template match< A, rewind_mode::required, Action, Control >( in, st... ) ) {
+         if constexpr( char_class_scan< Rule, A, Action, Control > ) {
+            (void)match_char_class< Rule >( in );
+         }
+         else {
+            while( Control< Rule >::template match< A, rewind_mode::required, Action, Control >( in, st... ) ) {
+            }
          }
          return true;
       }
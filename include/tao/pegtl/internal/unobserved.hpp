@@ -0,0 +1,31 @@
+// Copyright (c) 2023 Dr. Colin Hirsch and Daniel Frey
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef TAO_PEGTL_INTERNAL_UNOBSERVED_HPP
+#define TAO_PEGTL_INTERNAL_UNOBSERVED_HPP
+
+#include <type_traits>
+
+#include "../apply_mode.hpp"
+#include "../nothing.hpp"
+
+namespace tao::pegtl
+{
+   template< typename Rule >
+   struct normal;
+
+}  // namespace tao::pegtl
+
+namespace tao::pegtl::internal
+{
+   // Whether matching Rule calls neither control functions nor actions, i.e. whether
+   // the control is disabled for the Rule, or it is normal<> and there is no action.
+   // Rules that only look at the input can then be matched in bulk, or be skipped.
+
+   template< typename Rule, apply_mode A, template< typename... > class Action, template< typename... > class Control >
+   inline constexpr bool unobserved = !Control< Rule >::enable || ( std::is_same_v< Control< Rule >, normal< Rule > > && ( ( A == apply_mode::nothing ) || std::is_base_of_v< nothing< Rule >, Action< Rule > > ) );
+
+}  // namespace tao::pegtl::internal
+
+#endif
@@ -5,12 +5,28 @@
 #ifndef TAO_PEGTL_INTERNAL_UNTIL_HPP
 #define TAO_PEGTL_INTERNAL_UNTIL_HPP
 
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+#include "at.hpp"
+#include "bump_help.hpp"
 #include "bytes.hpp"
+#include "char_class.hpp"
+#include "cr_crlf_eol.hpp"
+#include "cr_eol.hpp"
+#include "crlf_eol.hpp"
 #include "enable_control.hpp"
 #include "eof.hpp"
+#include "eol.hpp"
+#include "eolf.hpp"
+#include "first_set.hpp"
+#include "lf_crlf_eol.hpp"
+#include "lf_eol.hpp"
 #include "not_at.hpp"
 #include "seq.hpp"
 #include "star.hpp"
+#include "unobserved.hpp"
 
 #include "../apply_mode.hpp"
 #include "../rewind_mode.hpp"
@@ -18,6 +34,162 @@
 
 namespace tao::pegtl::internal
 {
+   // Whether until< Cond > may skip the bytes at which Cond can not succeed without trying
+   // to match it there, which requires that Cond only looks at the input, and is either a
+   // rule without sub-rules or an at<> of one.
+
+   template< typename Cond, apply_mode A, template< typename... > class Action, template< typename... > class Control, typename = typename Cond::rule_t >
+   struct until_skip_ok
+   {
+      static constexpr bool value = unobserved< Cond, A, Action, Control > && std::is_same_v< typename Cond::subs_t, empty_list >;
+   };
+
+   template< typename Cond, apply_mode A, template< typename... > class Action, template< typename... > class Control, typename Rule >
+   struct until_skip_ok< Cond, A, Action, Control, at< Rule > >
+   {
+      static constexpr bool value = unobserved< Cond, A, Action, Control > && until_skip_ok< Rule, apply_mode::nothing, Action, Control >::value;
+   };
+
+   template< typename Eol >
+   inline constexpr bool until_skip_eol = std::is_base_of_v< cr_eol, Eol > || std::is_base_of_v< cr_crlf_eol, Eol > || std::is_base_of_v< crlf_eol, Eol > || std::is_base_of_v< lf_eol, Eol > || std::is_base_of_v< lf_crlf_eol, Eol >;
+
+   template< typename Cond, typename Eol, typename = typename Cond::rule_t >
+   struct until_skip_first
+   {
+      [[nodiscard]] static constexpr first_set get() noexcept
+      {
+         return first_of< Cond >();
+      }
+   };
+
+   template< typename Cond, typename Eol >
+   struct until_skip_first< Cond, Eol, eol >
+   {
+      [[nodiscard]] static constexpr first_set get() noexcept
+      {
+         if constexpr( until_skip_eol< Eol > ) {
+            return first_set_test( []( const char c ) { return ( c == '\n' ) || ( c == '\r' ); } );
+         }
+         else {
+            return first_set_all();
+         }
+      }
+   };
+
+   template< typename Cond, typename Eol >
+   struct until_skip_first< Cond, Eol, eolf >
+      : until_skip_first< eol, Eol >
+   {};
+
+   template< typename Cond, typename Eol, typename Rule >
+   struct until_skip_first< Cond, Eol, at< Rule > >
+      : until_skip_first< Rule, Eol >
+   {};
+
+   // Advances the input to the next byte at which Cond might succeed, or to the end of the
+   // input, with memchr() when that is a single byte, and with scan_char_class() otherwise.
+
+   template< typename Cond, typename Eol >
+   struct until_skip
+   {
+      using data_t = char;
+
+      static constexpr first_set set = until_skip_first< Cond, Eol >::get();
+
+      [[nodiscard]] static constexpr int single() noexcept
+      {
+         int r = -1;
+         for( std::size_t i = 0; i < 256; ++i ) {
+            if( set.bytes[ i ] ) {
+               if( r != -1 ) {
+                  return -1;
+               }
+               r = static_cast< int >( i );
+            }
+         }
+         return r;
+      }
+
+      [[nodiscard]] static constexpr bool test_one( const char c ) noexcept
+      {
+         return !set.bytes[ static_cast< unsigned char >( c ) ];
+      }
+
+      [[nodiscard]] static constexpr bool test_any( const char c ) noexcept
+      {
+         return test_one( c );
+      }
+
+      template< typename ParseInput >
+      static void skip( ParseInput& in )
+      {
+         while( const std::size_t available = in.size( 1 ) ) {
+            const char* p = in.current();
+            std::size_t count = available;
+            if constexpr( single() != -1 ) {
+               if( const void* q = std::memchr( p, single(), available ) ) {
+                  count = static_cast< std::size_t >( static_cast< const char* >( q ) - p );
+               }
+            }
+            else {
+               count = scan_char_class< until_skip >( p, available );
+            }
+            if( count != 0 ) {
+               bump_help< until_skip >( in, count );
+            }
+            if( count < available ) {
+               return;
+            }
+         }
+      }
+   };
+
+   template< typename Cond, apply_mode A, template< typename... > class Action, template< typename... > class Control, typename Eol >
+   [[nodiscard]] constexpr bool until_skip_enabled() noexcept
+   {
+      if constexpr( until_skip_ok< Cond, A, Action, Control >::value ) {
+         return !until_skip< Cond, Eol >::set.empty;
+      }
+      else {
+         return false;
+      }
+   }
+
+   // Attempts to match Cond at every position of the input, skipping the bytes at which it
+   // can not succeed when possible, until it succeeds or the end of the input is reached.
+
+   template< typename Cond,
+             apply_mode A,
+             template< typename... >
+             class Action,
+             template< typename... >
+             class Control,
+             typename ParseInput,
+             typename... States >
+   [[nodiscard]] bool until_match( ParseInput& in, States&&... st )
+   {
+      if constexpr( until_skip_enabled< Cond, A, Action, Control, typename ParseInput::eol_t >() ) {
+         using skip_t = until_skip< Cond, typename ParseInput::eol_t >;
+         skip_t::skip( in );
+         while( !Control< Cond >::template match< A, rewind_mode::required, Action, Control >( in, st... ) ) {
+            if( in.empty() ) {
+               return false;
+            }
+            in.bump();
+            skip_t::skip( in );
+         }
+      }
+      else {
+         while( !Control< Cond >::template match< A, rewind_mode::required, Action, Control >( in, st... ) ) {
+            if( in.empty() ) {
+               return false;
+            }
+            in.bump();
+         }
+      }
+      return true;
+   }
+
    template< typename Cond, typename... Rules >
    struct until
       : until< Cond, seq< Rules... > >
@@ -40,14 +212,7 @@ namespace tao::pegtl::internal
       [[nodiscard]] static bool match( ParseInput& in, States&&... st )
       {
          auto m = in.template auto_rewind< M >();
-
-         while( !Control< Cond >::template match< A, rewind_mode::required, Action, Control >( in, st... ) ) {
-            if( in.empty() ) {
-               return false;
-            }
-            in.bump();
-         }
-         return m( true );
+         return m( until_match< Cond, A, Action, Control >( in, st... ) );
       }
    };
 
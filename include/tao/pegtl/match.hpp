@@ -18,6 +18,7 @@
 #include "internal/has_unwind.hpp"
 #include "internal/missing_apply.hpp"
 #include "internal/missing_apply0.hpp"
+#include "internal/rewind_elision.hpp"
 #include "internal/rewind_guard.hpp"
 #include "internal/unwind_guard.hpp"
 
@@ -101,8 +102,10 @@ namespace tao::pegtl
              typename... States >
    [[nodiscard]] auto match( ParseInput& in, States&&... st )
    {
+      constexpr rewind_mode N = internal::rewind_elision< Rule, A, M, Action, Control >;
+
       if constexpr( !Control< Rule >::enable ) {
-         return internal::match_no_control< Rule, A, M, Action, Control >( in, st... );
+         return internal::match_no_control< Rule, A, N, Action, Control >( in, st... );
       }
       else {
          constexpr bool enable_action = ( A == apply_mode::action );
@@ -138,7 +141,7 @@ namespace tao::pegtl
 
          auto m = in.template auto_rewind< ( use_guard ? rewind_mode::required : rewind_mode::dontcare ) >();
          Control< Rule >::start( static_cast< const ParseInput& >( in ), st... );
-         auto result = internal::match_control_unwind< Rule, A, ( use_guard ? rewind_mode::active : M ), Action, Control >( in, st... );
+         auto result = internal::match_control_unwind< Rule, A, ( use_guard ? rewind_mode::active : N ), Action, Control >( in, st... );
          if( result ) {
             if constexpr( has_apply_void ) {
                Control< Rule >::template apply< Action >( m.frobnicator(), static_cast< const ParseInput& >( in ), st... );
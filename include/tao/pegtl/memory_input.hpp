@@ -1,10 +1,11 @@
-// Copyright (c) 2014-2022 Dr. Colin Hirsch and Daniel Frey
+// Copyright (c) 2014-2023 Dr. Colin Hirsch and Daniel Frey
 // Distributed under the Boost Software License, Version 1.0.
 // (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
 
 #ifndef TAO_PEGTL_MEMORY_INPUT_HPP
 #define TAO_PEGTL_MEMORY_INPUT_HPP
 
+#include <algorithm>
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
@@ -13,6 +14,7 @@
 #include <string_view>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include "eol.hpp"
 #include "normal.hpp"
@@ -225,6 +227,50 @@ namespace tao::pegtl
          std::size_t private_depth = 0;
       };
 
+      // Like lazy tracking, except that the offsets of the first byte after each
+      // end-of-line character are collected on demand, and only up to the highest
+      // offset for which a position was requested, so that position() is a binary
+      // search. The index is never shrunk, and since it is extended by position()
+      // concurrent calls to position() on the same input are not thread-safe.
+
+      template< typename Eol, typename Source >
+      class memory_input_base< tracking_mode::indexed, Eol, Source >
+         : public memory_input_base< tracking_mode::lazy, Eol, Source >
+      {
+      public:
+         using typename memory_input_base< tracking_mode::lazy, Eol, Source >::frobnicator_t;
+
+         using memory_input_base< tracking_mode::lazy, Eol, Source >::memory_input_base;
+
+         [[nodiscard]] tao::pegtl::position position( const frobnicator_t it ) const
+         {
+            const auto offset = static_cast< std::size_t >( it - this->m_begin.data );
+            index_lines( offset );
+            const auto lines = static_cast< std::size_t >( std::upper_bound( m_lines.begin(), m_lines.end(), offset ) - m_lines.begin() );
+            const auto column = ( lines == 0 ) ? ( this->m_begin.column + offset ) : ( offset - m_lines[ lines - 1 ] + 1 );
+            return tao::pegtl::position( internal::frobnicator( it, this->m_begin.byte + offset, this->m_begin.line + lines, column ), this->m_source );
+         }
+
+      protected:
+         void index_lines( const std::size_t offset ) const
+         {
+            const char* p = this->m_begin.data + m_indexed;
+            const char* const e = this->m_begin.data + offset;
+            while( p < e ) {
+               const auto* n = static_cast< const char* >( std::memchr( p, Eol::ch, static_cast< std::size_t >( e - p ) ) );
+               if( n == nullptr ) {
+                  break;
+               }
+               p = n + 1;
+               m_lines.emplace_back( static_cast< std::size_t >( p - this->m_begin.data ) );
+            }
+            m_indexed = ( std::max )( m_indexed, offset );
+         }
+
+         mutable std::size_t m_indexed = 0;
+         mutable std::vector< std::size_t > m_lines;
+      };
+
    }  // namespace internal
 
    template< tracking_mode P = tracking_mode::eager, typename Eol = eol::lf_crlf, typename Source = std::string >
@@ -9,6 +9,7 @@
 
 #include "eol.hpp"
 #include "memory_input.hpp"
+#include "mmap_options.hpp"
 #include "tracking_mode.hpp"
 
 #include "internal/filesystem.hpp"
@@ -31,6 +32,15 @@ namespace tao::pegtl
          : mmap_input( path, internal::path_to_string( path ) )
       {}
 
+      mmap_input( const internal::filesystem::path& path, const mmap_options& options, const std::string& source )
+         : internal::mmap_file( path, options ),
+           memory_input< P, Eol >( data.begin(), data.end(), source )
+      {}
+
+      mmap_input( const internal::filesystem::path& path, const mmap_options& options )
+         : mmap_input( path, options, internal::path_to_string( path ) )
+      {}
+
       mmap_input( const mmap_input& ) = delete;
       mmap_input( mmap_input&& ) = delete;
 
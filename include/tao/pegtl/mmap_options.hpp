@@ -0,0 +1,23 @@
+// Copyright (c) 2023 Dr. Colin Hirsch and Daniel Frey
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef TAO_PEGTL_MMAP_OPTIONS_HPP
+#define TAO_PEGTL_MMAP_OPTIONS_HPP
+
+namespace tao::pegtl
+{
+   // Hints for how a file is mapped by mmap_input<>; options that are
+   // not supported on the current platform are silently ignored.
+
+   struct mmap_options
+   {
+      bool populate = false;    // Pre-fault the whole mapping, MAP_POPULATE.
+      bool sequential = false;  // Advise sequential access, MADV_SEQUENTIAL.
+      bool willneed = false;    // Start read-ahead of the whole file, MADV_WILLNEED.
+      bool hugepage = false;    // Allow transparent huge pages, MADV_HUGEPAGE.
+   };
+
+}  // namespace tao::pegtl
+
+#endif
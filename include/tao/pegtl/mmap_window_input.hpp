@@ -0,0 +1,104 @@
+// Copyright (c) 2023 Dr. Colin Hirsch and Daniel Frey
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef TAO_PEGTL_MMAP_WINDOW_INPUT_HPP
+#define TAO_PEGTL_MMAP_WINDOW_INPUT_HPP
+
+#include <cassert>
+#include <cstddef>
+#include <string>
+
+#include "eol.hpp"
+#include "memory_input.hpp"
+
+#include "internal/action_input.hpp"
+#include "internal/buffer_input_base.hpp"
+#include "internal/filesystem.hpp"
+#include "internal/mmap_window.hpp"
+#include "internal/path_to_string.hpp"
+
+namespace tao::pegtl
+{
+   // Like buffer_input, except that the data is not read into a buffer but
+   // mapped from a file, only ever mapping a window of bounded size around
+   // the current position. The pages before current() are dropped from the
+   // resident set on discard(), which moves the window forward when less than
+   // maximum plus Chunk bytes remain mapped after current(). Data before the
+   // last discard() must not be accessed, exactly as with buffer_input.
+   // When moving the window fails the old one is kept, and require() will
+   // eventually throw the same overflow error as buffer_input.
+
+   template< typename Eol = eol::lf_crlf, std::size_t Chunk = 64 >
+   class mmap_window_input
+      : public internal::buffer_input_base< mmap_window_input< Eol, Chunk >, Eol, std::string >
+   {
+   public:
+      using action_t = internal::action_input< mmap_window_input >;
+
+      static constexpr std::size_t chunk_size = Chunk;
+
+      mmap_window_input( const internal::filesystem::path& path, const std::size_t maximum, const std::string& source )
+         : internal::buffer_input_base< mmap_window_input, Eol, std::string >( source ),
+           m_maximum( maximum + Chunk ),
+           m_window( path, 2 * m_maximum )
+      {
+         static_assert( Chunk != 0, "zero chunk size not implemented" );
+         assert( m_maximum > maximum );  // Catches overflow; change to >= when zero chunk size is implemented.
+         this->m_current.data = m_window.begin();
+      }
+
+      mmap_window_input( const internal::filesystem::path& path, const std::size_t maximum )
+         : mmap_window_input( path, maximum, internal::path_to_string( path ) )
+      {}
+
+      void discard() noexcept
+      {
+         if( ( !m_window.at_eof() ) && ( buffer_occupied() < m_maximum ) ) {
+            const std::size_t offset = m_window.offset() + buffer_free_before_current();
+            if( m_window.map( offset ) ) {
+               this->m_current.data = m_window.begin() + ( offset - m_window.offset() );
+               return;
+            }
+         }
+         m_window.release( this->m_current.data );
+      }
+
+      void require( const std::size_t amount )
+      {
+         if( ( this->m_current.data + amount > m_window.end() ) && ( !m_window.at_eof() ) ) {
+            this->require_overflow();
+         }
+      }
+
+      [[nodiscard]] std::size_t buffer_capacity() const noexcept
+      {
+         return m_window.length();
+      }
+
+      [[nodiscard]] std::size_t buffer_occupied() const noexcept
+      {
+         assert( m_window.end() >= this->m_current.data );
+         return static_cast< std::size_t >( m_window.end() - this->m_current.data );
+      }
+
+      [[nodiscard]] std::size_t buffer_free_before_current() const noexcept
+      {
+         assert( this->m_current.data >= m_window.begin() );
+         return static_cast< std::size_t >( this->m_current.data - m_window.begin() );
+      }
+
+      [[nodiscard]] std::size_t buffer_free_after_end() const noexcept
+      {
+         assert( m_window.begin() + m_window.length() >= m_window.end() );
+         return static_cast< std::size_t >( m_window.begin() + m_window.length() - m_window.end() );
+      }
+
+   private:
+      const std::size_t m_maximum;
+      internal::mmap_window m_window;
+   };
+
+}  // namespace tao::pegtl
+
+#endif
@@ -0,0 +1,110 @@
+// Copyright (c) 2023 Dr. Colin Hirsch and Daniel Frey
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef TAO_PEGTL_RING_BUFFER_INPUT_HPP
+#define TAO_PEGTL_RING_BUFFER_INPUT_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <string>
+
+#include "eol.hpp"
+#include "memory_input.hpp"
+
+#include "internal/action_input.hpp"
+#include "internal/buffer_input_base.hpp"
+#include "internal/ring_buffer.hpp"
+
+namespace tao::pegtl
+{
+   // Like buffer_input, except that discard() never moves any data; the buffer is a
+   // double-mapped ring buffer and discard() only releases the space before current(),
+   // while everything between current() and end() remains one contiguous range.
+   // The buffer size is rounded up to a multiple of the page size.
+
+   template< typename Reader, typename Eol = eol::lf_crlf, typename Source = std::string, std::size_t Chunk = 64 >
+   class ring_buffer_input
+      : public internal::buffer_input_base< ring_buffer_input< Reader, Eol, Source, Chunk >, Eol, Source >
+   {
+   public:
+      using reader_t = Reader;
+
+      using action_t = internal::action_input< ring_buffer_input >;
+
+      static constexpr std::size_t chunk_size = Chunk;
+
+      template< typename T, typename... As >
+      ring_buffer_input( T&& in_source, const std::size_t maximum, As&&... as )
+         : internal::buffer_input_base< ring_buffer_input, Eol, Source >( std::forward< T >( in_source ) ),
+           m_reader( std::forward< As >( as )... ),
+           m_buffer( maximum + Chunk ),
+           m_begin( m_buffer.data() ),
+           m_end( m_buffer.data() )
+      {
+         static_assert( Chunk != 0, "zero chunk size not implemented" );
+         assert( maximum + Chunk > maximum );  // Catches overflow; change to >= when zero chunk size is implemented.
+         this->m_current.data = m_buffer.data();
+      }
+
+      void discard() noexcept
+      {
+         m_begin = this->m_current.data;
+         if( m_begin >= m_buffer.data() + m_buffer.size() ) {
+            m_begin -= m_buffer.size();
+            this->m_current.data -= m_buffer.size();
+            m_end -= m_buffer.size();
+         }
+      }
+
+      void require( const std::size_t amount )
+      {
+         if( this->m_current.data + amount <= m_end ) {
+            return;
+         }
+         if( this->m_current.data + amount > m_begin + m_buffer.size() ) {
+            this->require_overflow();
+         }
+         do {
+            const std::size_t r = m_reader( m_end, ( std::min )( buffer_free_after_end(), ( std::max )( amount - buffer_occupied(), Chunk ) ) );
+            if( r == 0 ) {
+               return;
+            }
+            m_end += r;
+         } while( this->m_current.data + amount > m_end );
+      }
+
+      [[nodiscard]] std::size_t buffer_capacity() const noexcept
+      {
+         return m_buffer.size();
+      }
+
+      [[nodiscard]] std::size_t buffer_occupied() const noexcept
+      {
+         assert( m_end >= this->m_current.data );
+         return static_cast< std::size_t >( m_end - this->m_current.data );
+      }
+
+      [[nodiscard]] std::size_t buffer_free_before_current() const noexcept
+      {
+         assert( this->m_current.data >= m_begin );
+         return static_cast< std::size_t >( this->m_current.data - m_begin );
+      }
+
+      [[nodiscard]] std::size_t buffer_free_after_end() const noexcept
+      {
+         assert( m_begin + m_buffer.size() >= m_end );
+         return static_cast< std::size_t >( m_begin + m_buffer.size() - m_end );
+      }
+
+   private:
+      Reader m_reader;
+      internal::ring_buffer m_buffer;
+      const char* m_begin;
+      char* m_end;
+   };
+
+}  // namespace tao::pegtl
+
+#endif
@@ -50,12 +50,14 @@ namespace tao::pegtl
    template< unsigned Amount > struct require : internal::require< Amount > {};
    template< typename... Rules > struct seq : internal::seq< Rules... > {};
    template< typename... Rules > struct sor : internal::sor< Rules... > {};
+   template< typename... Rules > struct sor_dispatch : internal::sor_dispatch< Rules... > {};
    template< typename Rule, typename... Rules > struct star : internal::star< Rule, Rules... > {};
    template< typename State, typename... Rules > struct state : internal::state< State, Rules... > {};
    struct success : internal::success {};
    template< typename Cond, typename... Rules > struct until : internal::until< Cond, Rules... > {};
 
 #if defined( __cpp_exceptions )
+   struct cut : internal::cut {};
    template< typename Cond, typename... Thens > struct if_must : internal::if_must< false, Cond, Thens... > {};
    template< typename Cond, typename Then, typename Else > struct if_must_else : internal::if_must_else< Cond, Then, Else > {};
    template< typename Rule, typename Sep, typename Pad = void > struct list_must : internal::list_must< Rule, internal::pad< Sep, Pad > > {};
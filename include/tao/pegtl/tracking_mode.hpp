@@ -1,4 +1,4 @@
-// Copyright (c) 2017-2022 Dr. Colin Hirsch and Daniel Frey
+// Copyright (c) 2017-2023 Dr. Colin Hirsch and Daniel Frey
 // Distributed under the Boost Software License, Version 1.0.
 // (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
 
@@ -7,10 +7,11 @@
 
 namespace tao::pegtl
 {
-   enum class tracking_mode : bool
+   enum class tracking_mode : char
    {
       eager,
-      lazy
+      lazy,
+      indexed
    };
 
 }  // namespace tao::pegtl
@@ -5,8 +5,11 @@
 #ifndef TAO_PEGTL_VISIT_HPP
 #define TAO_PEGTL_VISIT_HPP
 
+#include <cstddef>
+#include <string_view>
 #include <type_traits>
 
+#include "demangle.hpp"
 #include "type_list.hpp"
 
 namespace tao::pegtl
@@ -55,6 +58,29 @@ namespace tao::pegtl
          : visit_list< Done, Rules... >
       {};
 
+      template< typename Rule, typename... Rules >
+      [[nodiscard]] constexpr std::size_t rule_index( type_list< Rules... > /*unused*/ ) noexcept
+      {
+         constexpr bool same[] = { std::is_same_v< Rule, Rules >... };
+         for( std::size_t i = 0; i < sizeof...( Rules ); ++i ) {
+            if( same[ i ] ) {
+               return i;
+            }
+         }
+         return sizeof...( Rules );
+      }
+
+      template< typename Rules >
+      struct rule_names;
+
+      // Not constexpr since demangle() is not with all compilers.
+
+      template< typename... Rules >
+      struct rule_names< type_list< Rules... > >
+      {
+         static inline const std::string_view value[] = { demangle< Rules >()... };
+      };
+
       template< template< typename... > class Func, typename... Args, typename... Rules >
       void visit( type_list< Rules... > /*unused*/, Args&&... args )
       {
@@ -69,6 +95,24 @@ namespace tao::pegtl
    template< typename Grammar, typename Rule >
    inline constexpr bool contains_v = internal::contains< Rule, rule_list_t< Grammar > >::value;
 
+   // Dense integer identifiers for all rules of a grammar, from 0 to rule_list_t< Grammar >::size - 1.
+
+   template< typename Grammar, typename Rule >
+   struct rule_id
+      : std::integral_constant< std::size_t, internal::rule_index< Rule >( rule_list_t< Grammar >() ) >
+   {
+      static_assert( contains_v< Grammar, Rule >, "rule not found in grammar" );
+   };
+
+   template< typename Grammar, typename Rule >
+   inline constexpr std::size_t rule_id_v = rule_id< Grammar, Rule >::value;
+
+   template< typename Grammar >
+   [[nodiscard]] std::string_view rule_name( const std::size_t id ) noexcept
+   {
+      return internal::rule_names< rule_list_t< Grammar > >::value[ id ];
+   }
+
    template< typename Rule, template< typename... > class Func, typename... Args >
    void visit( Args&&... args )
    {
@@ -0,0 +1,71 @@
+// Copyright (c) 2023 Dr. Colin Hirsch and Daniel Frey
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include <tao/pegtl/internal/bump.hpp>
+
+namespace tao::pegtl
+{
+   // The byte-by-byte loop that internal::bump() used before it was vectorised.
+
+   void bump_reference( internal::frobnicator& iter, const std::size_t count, const int ch ) noexcept
+   {
+      for( std::size_t i = 0; i < count; ++i ) {
+         if( iter.data[ i ] == ch ) {
+            ++iter.line;
+            iter.column = 1;
+         }
+         else {
+            ++iter.column;
+         }
+      }
+      iter.byte += count;
+      iter.data += count;
+   }
+
+   template< typename F >
+   double measure( const std::string& data, const std::size_t block, const std::size_t rounds, std::size_t& lines, F&& f )
+   {
+      const auto start = std::chrono::steady_clock::now();
+      for( std::size_t r = 0; r < rounds; ++r ) {
+         internal::frobnicator iter( data.data() );
+         for( std::size_t i = 0; i + block <= data.size(); i += block ) {
+            f( iter, block, '\n' );
+         }
+         lines += iter.line;
+      }
+      const std::chrono::duration< double, std::nano > d = std::chrono::steady_clock::now() - start;
+      return d.count() / double( rounds * data.size() );
+   }
+
+}  // namespace tao::pegtl
+
+int main( int argc, char** argv )  // NOLINT(bugprone-exception-escape)
+{
+   using namespace tao::pegtl;
+
+   const std::size_t size = ( argc > 1 ) ? std::size_t( std::atol( argv[ 1 ] ) ) : ( 1 << 20 );
+   const std::size_t rounds = ( argc > 2 ) ? std::size_t( std::atol( argv[ 2 ] ) ) : 100;
+   const std::size_t block = 4096;
+
+   std::size_t lines = 0;  // Consumed so that the work is not optimised away.
+
+   std::cout << "line length    reference ns/byte    bump ns/byte" << std::endl;
+   for( const std::size_t length : { 1, 4, 16, 40, 80, 256, 4096 } ) {
+      std::string data( size, 'x' );
+      for( std::size_t i = length - 1; i < size; i += length ) {
+         data[ i ] = '\n';
+      }
+      const double a = measure( data, block, rounds, lines, bump_reference );
+      const double b = measure( data, block, rounds, lines, internal::bump );
+      std::cout << std::setw( 11 ) << length << std::setw( 21 ) << std::fixed << std::setprecision( 3 ) << a << std::setw( 16 ) << b << std::endl;
+   }
+   return ( lines != 0 ) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,71 @@
+// Copyright (c) 2023 Dr. Colin Hirsch and Daniel Frey
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+
+#include <tao/pegtl.hpp>
+#include <tao/pegtl/contrib/predicates.hpp>
+
+namespace tao::pegtl
+{
+   // The character classes of the URI grammar, combined into single rules.
+
+   // clang-format off
+   struct sub_delims : one< '!', '$', '&', '\'', '(', ')', '*', '+', ',', ';', '=' > {};
+   struct unreserved : predicates_or< alpha, digit, one< '-', '.', '_', '~' > > {};
+   struct pchar : predicates_or< unreserved, sub_delims, one< '%', ':', '@' > > {};
+   // clang-format on
+
+   template< typename F >
+   double measure( const std::string& data, const std::size_t rounds, std::size_t& count, const F& f )
+   {
+      const auto start = std::chrono::steady_clock::now();
+      for( std::size_t r = 0; r < rounds; ++r ) {
+         for( const char c : data ) {
+            count += f( c );
+         }
+      }
+      const std::chrono::duration< double, std::nano > d = std::chrono::steady_clock::now() - start;
+      return d.count() / double( rounds * data.size() );
+   }
+
+   template< typename Rule >
+   void compare( const char* name, const std::string& data, const std::size_t rounds, std::size_t& count )
+   {
+      const double a = measure( data, rounds, count, []( const char c ) { return Rule::test_compare( c ); } );
+      const double b = measure( data, rounds, count, []( const char c ) { return Rule::test_one( c ); } );
+      std::cout << std::setw( 11 ) << name << std::setw( 19 ) << std::fixed << std::setprecision( 3 ) << a << std::setw( 17 ) << b << std::endl;
+   }
+
+}  // namespace tao::pegtl
+
+int main( int argc, char** argv )  // NOLINT(bugprone-exception-escape)
+{
+   using namespace tao::pegtl;
+
+   const std::size_t size = ( argc > 1 ) ? std::size_t( std::atol( argv[ 1 ] ) ) : ( 1 << 20 );
+   const std::size_t rounds = ( argc > 2 ) ? std::size_t( std::atol( argv[ 2 ] ) ) : 100;
+
+   std::string data( size, ' ' );
+   std::mt19937 gen( 42 );
+   std::uniform_int_distribution< int > dist( 0, 127 );
+   for( char& c : data ) {
+      c = static_cast< char >( dist( gen ) );
+   }
+   std::size_t count = 0;  // Consumed so that the work is not optimised away.
+
+   std::cout << "class      compare ns/byte    table ns/byte" << std::endl;
+   compare< xdigit >( "xdigit", data, rounds, count );
+   compare< space >( "space", data, rounds, count );
+   compare< sub_delims >( "sub_delims", data, rounds, count );
+   compare< unreserved >( "unreserved", data, rounds, count );
+   compare< pchar >( "pchar", data, rounds, count );
+   return ( count != 0 ) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
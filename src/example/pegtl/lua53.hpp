@@ -127,15 +127,9 @@ namespace lua53
    struct str_until : TAO_PEGTL_STRING( "until" ) {};
    struct str_while : TAO_PEGTL_STRING( "while" ) {};
 
-   // Note that 'elseif' precedes 'else' in order to prevent only matching
-   // the "else" part of an "elseif" and running into an error in the
-   // 'keyword' rule.
-
    template< typename Key >
    struct key : tao::pegtl::seq< Key, tao::pegtl::not_at< tao::pegtl::identifier_other > > {};
 
-   struct sor_keyword : tao::pegtl::sor< str_and, str_break, str_do, str_elseif, str_else, str_end, str_false, str_for, str_function, str_goto, str_if, str_in, str_local, str_nil, str_not, str_repeat, str_return, str_then, str_true, str_until, str_while > {};
-
    struct key_and : key< str_and > {};
    struct key_break : key< str_break > {};
    struct key_do : key< str_do > {};
@@ -159,7 +153,7 @@ namespace lua53
    struct key_until : key< str_until > {};
    struct key_while : key< str_while > {};
 
-   struct keyword : key< sor_keyword > {};
+   struct keyword : tao::pegtl::keywords< str_and, str_break, str_do, str_else, str_elseif, str_end, str_false, str_for, str_function, str_goto, str_if, str_in, str_local, str_nil, str_not, str_repeat, str_return, str_then, str_true, str_until, str_while > {};
 
    template< typename R >
    struct pad : tao::pegtl::pad< R, sep > {};
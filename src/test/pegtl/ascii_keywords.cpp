@@ -0,0 +1,73 @@
+// Copyright (c) 2023 Dr. Colin Hirsch and Daniel Frey
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+#include "test.hpp"
+#include "verify_meta.hpp"
+#include "verify_rule.hpp"
+
+namespace tao::pegtl
+{
+   using test_keywords = keywords< TAO_PEGTL_STRING( "if" ), TAO_PEGTL_STRING( "in" ), TAO_PEGTL_STRING( "int" ), TAO_PEGTL_STRING( "else" ), TAO_PEGTL_STRING( "elif" ) >;
+   using test_ikeywords = ikeywords< TAO_PEGTL_STRING( "if" ), TAO_PEGTL_ISTRING( "ELSE" ) >;
+
+   struct test_grammar
+      : seq< test_keywords, star< space >, identifier, eof >
+   {};
+
+   void unit_test()
+   {
+      verify_meta< test_keywords, internal::keywords< false, internal::string< 'i', 'f' >, internal::string< 'i', 'n' >, internal::string< 'i', 'n', 't' >, internal::string< 'e', 'l', 's', 'e' >, internal::string< 'e', 'l', 'i', 'f' > > >();
+      verify_meta< test_ikeywords, internal::keywords< true, internal::string< 'i', 'f' >, internal::istring< 'E', 'L', 'S', 'E' > > >();
+
+      verify_analyze< test_keywords >( __LINE__, __FILE__, true, false );
+      verify_analyze< test_ikeywords >( __LINE__, __FILE__, true, false );
+
+      static_assert( internal::first_of< test_keywords >().bytes[ 'i' ] );
+      static_assert( internal::first_of< test_keywords >().bytes[ 'e' ] );
+      static_assert( !internal::first_of< test_keywords >().bytes[ 'n' ] );
+      static_assert( !internal::first_of< test_keywords >().bytes[ 'E' ] );
+      static_assert( !internal::first_of< test_keywords >().empty );
+      static_assert( internal::first_of< test_ikeywords >().bytes[ 'E' ] );
+      static_assert( internal::first_of< test_ikeywords >().bytes[ 'I' ] );
+
+      verify_rule< test_keywords >( __LINE__, __FILE__, "if", result_type::success, 0 );
+      verify_rule< test_keywords >( __LINE__, __FILE__, "in", result_type::success, 0 );
+      verify_rule< test_keywords >( __LINE__, __FILE__, "int", result_type::success, 0 );
+      verify_rule< test_keywords >( __LINE__, __FILE__, "else", result_type::success, 0 );
+      verify_rule< test_keywords >( __LINE__, __FILE__, "elif", result_type::success, 0 );
+      verify_rule< test_keywords >( __LINE__, __FILE__, "if ", result_type::success, 1 );
+      verify_rule< test_keywords >( __LINE__, __FILE__, "in(", result_type::success, 1 );
+      verify_rule< test_keywords >( __LINE__, __FILE__, "int x", result_type::success, 2 );
+      verify_rule< test_keywords >( __LINE__, __FILE__, "else if", result_type::success, 3 );
+      verify_rule< test_keywords >( __LINE__, __FILE__, "", result_type::local_failure, 0 );
+      verify_rule< test_keywords >( __LINE__, __FILE__, "i", result_type::local_failure, 1 );
+      verify_rule< test_keywords >( __LINE__, __FILE__, "el", result_type::local_failure, 2 );
+      verify_rule< test_keywords >( __LINE__, __FILE__, "els", result_type::local_failure, 3 );
+      verify_rule< test_keywords >( __LINE__, __FILE__, "inx", result_type::local_failure, 3 );
+      verify_rule< test_keywords >( __LINE__, __FILE__, "intx", result_type::local_failure, 4 );
+      verify_rule< test_keywords >( __LINE__, __FILE__, "int_", result_type::local_failure, 4 );
+      verify_rule< test_keywords >( __LINE__, __FILE__, "elif1", result_type::local_failure, 5 );
+      verify_rule< test_keywords >( __LINE__, __FILE__, "IF", result_type::local_failure, 2 );
+      verify_rule< test_keywords >( __LINE__, __FILE__, " if", result_type::local_failure, 3 );
+      verify_rule< test_keywords >( __LINE__, __FILE__, "for", result_type::local_failure, 3 );
+
+      verify_rule< test_ikeywords >( __LINE__, __FILE__, "if", result_type::success, 0 );
+      verify_rule< test_ikeywords >( __LINE__, __FILE__, "IF", result_type::success, 0 );
+      verify_rule< test_ikeywords >( __LINE__, __FILE__, "iF ", result_type::success, 1 );
+      verify_rule< test_ikeywords >( __LINE__, __FILE__, "else", result_type::success, 0 );
+      verify_rule< test_ikeywords >( __LINE__, __FILE__, "ElSe+", result_type::success, 1 );
+      verify_rule< test_ikeywords >( __LINE__, __FILE__, "elsex", result_type::local_failure, 5 );
+      verify_rule< test_ikeywords >( __LINE__, __FILE__, "in", result_type::local_failure, 2 );
+
+      {
+         memory_input in( "int\n  foo", __FUNCTION__ );
+         TAO_PEGTL_TEST_ASSERT( parse< test_grammar >( in ) );
+         TAO_PEGTL_TEST_ASSERT( in.position().line == 2 );
+         TAO_PEGTL_TEST_ASSERT( in.position().column == 6 );
+      }
+   }
+
+}  // namespace tao::pegtl
+
+#include "main.hpp"
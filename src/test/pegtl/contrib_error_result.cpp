@@ -0,0 +1,142 @@
+// Copyright (c) 2023 Dr. Colin Hirsch and Daniel Frey
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined( __cpp_exceptions )
+#include <iostream>
+int main()
+{
+   std::cout << "Exception support disabled, skipping test..." << std::endl;
+}
+#else
+
+#include <string>
+
+#include "test.hpp"
+
+#include <tao/pegtl/contrib/error_result.hpp>
+
+namespace tao::pegtl
+{
+   struct b : one< 'b' >
+   {};
+
+   struct grammar : seq< one< 'a' >, must< b >, one< 'c' > >
+   {};
+
+   struct alternatives : sor< seq< one< 'a' >, must< b > >, one< 'a' > >
+   {};
+
+   struct message : seq< one< 'a' >, raise_message< 'o', 'o', 'p', 's' > >
+   {};
+
+   struct lines : seq< plus< one< 'a' >, eol >, must< b > >
+   {};
+
+   struct counted : star< one< 'a' >, must< b > >
+   {};
+
+   template< typename Rule >
+   struct my_action
+      : nothing< Rule >
+   {};
+
+   template<>
+   struct my_action< counted >
+   {
+      template< typename ActionInput >
+      static void apply( const ActionInput& /*unused*/, unsigned& applied )
+      {
+         ++applied;
+      }
+   };
+
+   template<>
+   struct my_action< b >
+   {
+      static void apply0( unsigned& applied )
+      {
+         ++applied;
+      }
+   };
+
+   void unit_test()
+   {
+      {
+         memory_input in( "abc", __FUNCTION__ );
+         error_result< memory_input<> > error;
+         TAO_PEGTL_TEST_ASSERT( parse_error_result< grammar >( in, error ) );
+         TAO_PEGTL_TEST_ASSERT( !error );
+      }
+      {
+         memory_input in( "x", __FUNCTION__ );
+         error_result< memory_input<> > error;
+         TAO_PEGTL_TEST_ASSERT( !parse_error_result< grammar >( in, error ) );
+         TAO_PEGTL_TEST_ASSERT( !error );
+      }
+      {
+         memory_input in( "ac", __FUNCTION__ );
+         error_result< memory_input<> > error;
+         TAO_PEGTL_TEST_ASSERT( !parse_error_result< grammar >( in, error ) );
+         TAO_PEGTL_TEST_ASSERT( error );
+         TAO_PEGTL_TEST_ASSERT( error.rule == &demangle< b > );
+         TAO_PEGTL_TEST_ASSERT( error.rule() == demangle< b >() );
+         TAO_PEGTL_TEST_ASSERT( error.frobnicator.byte == 1 );
+         TAO_PEGTL_TEST_ASSERT( error.message() == "parse error matching " + std::string( demangle< b >() ) );
+         const auto p = error.position( in );
+         TAO_PEGTL_TEST_ASSERT( p.byte == 1 );
+         TAO_PEGTL_TEST_ASSERT( p.line == 1 );
+         TAO_PEGTL_TEST_ASSERT( p.column == 2 );
+         TAO_PEGTL_TEST_ASSERT( p.source == __FUNCTION__ );
+         TAO_PEGTL_TEST_THROWS( error.raise( in ) );
+      }
+      {
+         // The error is not a local failure, the second alternative is not attempted.
+         memory_input in( "ac", __FUNCTION__ );
+         error_result< memory_input<> > error;
+         TAO_PEGTL_TEST_ASSERT( !parse_error_result< alternatives >( in, error ) );
+         TAO_PEGTL_TEST_ASSERT( error );
+         TAO_PEGTL_TEST_ASSERT( error.frobnicator.byte == 1 );
+      }
+      {
+         memory_input in( "ab", __FUNCTION__ );
+         error_result< memory_input<> > error;
+         TAO_PEGTL_TEST_ASSERT( !parse_error_result< message >( in, error ) );
+         TAO_PEGTL_TEST_ASSERT( error );
+         TAO_PEGTL_TEST_ASSERT( error.message() == "oops" );
+      }
+      {
+         memory_input< tracking_mode::lazy > in( "a\na\nc", __FUNCTION__ );
+         error_result< memory_input< tracking_mode::lazy > > error;
+         TAO_PEGTL_TEST_ASSERT( !parse_error_result< lines >( in, error ) );
+         TAO_PEGTL_TEST_ASSERT( error );
+         const auto p = error.position( in );
+         TAO_PEGTL_TEST_ASSERT( p.byte == 4 );
+         TAO_PEGTL_TEST_ASSERT( p.line == 3 );
+         TAO_PEGTL_TEST_ASSERT( p.column == 1 );
+      }
+      {
+         // No more actions are applied once the error is recorded.
+         memory_input in( "ababac", __FUNCTION__ );
+         error_result< memory_input<> > error;
+         unsigned applied = 0;
+         TAO_PEGTL_TEST_ASSERT( !parse_error_result< counted, my_action >( in, error, applied ) );
+         TAO_PEGTL_TEST_ASSERT( error );
+         TAO_PEGTL_TEST_ASSERT( error.frobnicator.byte == 5 );
+         TAO_PEGTL_TEST_ASSERT( applied == 2 );
+      }
+      {
+         memory_input in( "ababab", __FUNCTION__ );
+         error_result< memory_input<> > error;
+         unsigned applied = 0;
+         TAO_PEGTL_TEST_ASSERT( parse_error_result< counted, my_action >( in, error, applied ) );
+         TAO_PEGTL_TEST_ASSERT( !error );
+         TAO_PEGTL_TEST_ASSERT( applied == 4 );
+      }
+   }
+
+}  // namespace tao::pegtl
+
+#include "main.hpp"
+
+#endif
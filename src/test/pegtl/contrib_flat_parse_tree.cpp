@@ -0,0 +1,228 @@
+// Copyright (c) 2023 Dr. Colin Hirsch and Daniel Frey
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "test.hpp"
+
+#include <tao/pegtl/contrib/flat_parse_tree.hpp>
+
+namespace tao::pegtl
+{
+   // clang-format off
+   struct A : one< 'a' > {};
+   struct B : one< 'b' > {};
+   struct C : one< 'c' > {};
+
+   struct D : sor< seq< A, B >, seq< A, C > > {};
+   struct E : star< A, B > {};
+   struct F : seq< E > {};
+
+#if defined( __cpp_exceptions )
+   struct D2 : sor< try_catch< if_must< A, B > >, seq< A, C > > {};
+#else
+   struct D2 : D {};
+#endif
+
+   struct G : seq< A, opt< eol >, C > {};
+   // clang-format on
+
+   template< typename Rule >
+   using selector = parse_tree::selector< Rule,
+                                          parse_tree::store_content::on< A, B >,
+                                          parse_tree::remove_content::on< C >,
+                                          parse_tree::fold_one::on< D > >;
+
+   template< typename Rule >
+   using selector2 = parse_tree::selector< Rule,
+                                           parse_tree::store_content::on< A >,
+                                           parse_tree::discard_empty::on< B >,
+                                           parse_tree::discard_empty::on< F >,
+                                           parse_tree::fold_one::on< E > >;
+
+   template< typename Grammar >
+   [[nodiscard]] std::vector< std::uint32_t > children( const parse_tree::flat_tree< Grammar >& t, const typename parse_tree::flat_tree< Grammar >::node& n )
+   {
+      std::vector< std::uint32_t > result;
+      for( auto i = n.first_child; i != t.npos; i = t[ i ].next_sibling ) {
+         result.push_back( i );
+      }
+      return result;
+   }
+
+   void unit_test()
+   {
+      {
+         memory_input in( "ac", "input" );
+         const auto r = parse_tree::parse_flat< D, selector >( in );
+         TAO_PEGTL_TEST_ASSERT( r );
+         TAO_PEGTL_TEST_ASSERT( r->is_root( r->root() ) );
+         TAO_PEGTL_TEST_ASSERT( !r->has_content( r->root() ) );
+         TAO_PEGTL_TEST_ASSERT( r->type( r->root() ).empty() );
+         const auto c = children( *r, r->root() );
+         TAO_PEGTL_TEST_ASSERT( c.size() == 1 );
+
+         const auto& d = ( *r )[ c.front() ];
+         TAO_PEGTL_TEST_ASSERT( !r->is_root( d ) );
+         TAO_PEGTL_TEST_ASSERT( r->is_type< D >( d ) );
+         TAO_PEGTL_TEST_ASSERT( r->type( d ) == demangle< D >() );
+         TAO_PEGTL_TEST_ASSERT( !r->has_content( d ) );
+
+         const auto dc = children( *r, d );
+         TAO_PEGTL_TEST_ASSERT( dc.size() == 2 );
+         TAO_PEGTL_TEST_ASSERT( r->is_type< A >( ( *r )[ dc.front() ] ) );
+         TAO_PEGTL_TEST_ASSERT( r->string_view( ( *r )[ dc.front() ] ) == "a" );
+         TAO_PEGTL_TEST_ASSERT( r->is_type< C >( ( *r )[ dc.back() ] ) );
+         TAO_PEGTL_TEST_ASSERT( !r->has_content( ( *r )[ dc.back() ] ) );
+
+         // The A of the failed first alternative was removed.
+         TAO_PEGTL_TEST_ASSERT( r->nodes.size() == 4 );
+
+         memory_input in2( "x", "input" );
+         TAO_PEGTL_TEST_ASSERT( !parse_tree::parse_flat< D, selector >( in2 ) );
+      }
+
+      {
+         memory_input in( "aba", "input" );
+         const auto r = parse_tree::parse_flat< E, selector >( in );
+         TAO_PEGTL_TEST_ASSERT( r );
+         const auto c = children( *r, r->root() );
+         TAO_PEGTL_TEST_ASSERT( c.size() == 2 );
+         TAO_PEGTL_TEST_ASSERT( r->is_type< A >( ( *r )[ c.front() ] ) );
+         TAO_PEGTL_TEST_ASSERT( r->is_type< B >( ( *r )[ c.back() ] ) );
+      }
+
+      {
+         memory_input in( "ab", "input" );
+         const auto r = parse_tree::parse_flat< E, selector2 >( in );
+         TAO_PEGTL_TEST_ASSERT( r );
+         const auto c = children( *r, r->root() );
+         TAO_PEGTL_TEST_ASSERT( c.size() == 1 );
+         TAO_PEGTL_TEST_ASSERT( r->is_type< A >( ( *r )[ c.front() ] ) );
+         // The folded E was replaced by its only child.
+         TAO_PEGTL_TEST_ASSERT( r->nodes.size() == 2 );
+      }
+
+      {
+         memory_input in( "aba", "input" );
+         const auto r = parse_tree::parse_flat< F, selector2 >( in );
+         TAO_PEGTL_TEST_ASSERT( r );
+         const auto c = children( *r, r->root() );
+         TAO_PEGTL_TEST_ASSERT( c.size() == 1 );
+
+         const auto& f = ( *r )[ c.front() ];
+         TAO_PEGTL_TEST_ASSERT( r->is_type< F >( f ) );
+         TAO_PEGTL_TEST_ASSERT( !r->has_content( f ) );
+         const auto fc = children( *r, f );
+         TAO_PEGTL_TEST_ASSERT( fc.size() == 1 );
+         TAO_PEGTL_TEST_ASSERT( r->nodes.size() == 3 );
+
+         const auto& a = ( *r )[ fc.front() ];
+         TAO_PEGTL_TEST_ASSERT( r->is_type< A >( a ) );
+         TAO_PEGTL_TEST_ASSERT( r->has_content( a ) );
+         TAO_PEGTL_TEST_ASSERT( a.first_child == r->npos );
+      }
+
+      {
+         memory_input in( "ac", "input" );
+         const auto r = parse_tree::parse_flat< D2, selector >( in );
+         TAO_PEGTL_TEST_ASSERT( r );
+         const auto c = children( *r, r->root() );
+         TAO_PEGTL_TEST_ASSERT( c.size() == 2 );
+         TAO_PEGTL_TEST_ASSERT( r->is_type< A >( ( *r )[ c.front() ] ) );
+         TAO_PEGTL_TEST_ASSERT( r->is_type< C >( ( *r )[ c.back() ] ) );
+      }
+
+      {
+         memory_input in( "ac", "input" );
+         const auto r = parse_tree::parse_flat< D2 >( in );
+         TAO_PEGTL_TEST_ASSERT( r );
+         const auto c = children( *r, r->root() );
+         TAO_PEGTL_TEST_ASSERT( c.size() == 1 );
+
+         const auto& d2 = ( *r )[ c.front() ];
+         TAO_PEGTL_TEST_ASSERT( r->is_type< D2 >( d2 ) );
+         TAO_PEGTL_TEST_ASSERT( r->has_content( d2 ) );
+         TAO_PEGTL_TEST_ASSERT( r->begin( d2 ).byte == 0 );
+         TAO_PEGTL_TEST_ASSERT( r->end( d2 ).byte == 2 );
+         TAO_PEGTL_TEST_ASSERT( r->string( d2 ) == "ac" );
+
+         const auto& internal = ( *r )[ d2.first_child ];
+         TAO_PEGTL_TEST_ASSERT( internal.next_sibling == r->npos );
+         TAO_PEGTL_TEST_ASSERT( r->is_type< seq< A, C > >( internal ) );
+         TAO_PEGTL_TEST_ASSERT( r->string_view( internal ) == "ac" );
+
+         const auto ic = children( *r, internal );
+         TAO_PEGTL_TEST_ASSERT( ic.size() == 2 );
+         TAO_PEGTL_TEST_ASSERT( r->is_type< A >( ( *r )[ ic.front() ] ) );
+         TAO_PEGTL_TEST_ASSERT( r->is_type< C >( ( *r )[ ic.back() ] ) );
+      }
+
+      {
+         memory_input in( "a\r\nc", "input" );
+         const auto r = parse_tree::parse_flat< G, selector >( in );
+         TAO_PEGTL_TEST_ASSERT( r );
+         TAO_PEGTL_TEST_ASSERT( r->start.source == "input" );
+         const auto c = children( *r, r->root() );
+         TAO_PEGTL_TEST_ASSERT( c.size() == 2 );
+         const auto p = r->begin( ( *r )[ c.back() ] );
+         TAO_PEGTL_TEST_ASSERT( p.byte == 3 );
+         TAO_PEGTL_TEST_ASSERT( p.line == 2 );
+         TAO_PEGTL_TEST_ASSERT( p.column == 1 );
+         TAO_PEGTL_TEST_ASSERT( p.source == "input" );
+         const auto q = r->begin( ( *r )[ c.front() ] );
+         TAO_PEGTL_TEST_ASSERT( q.byte == 0 );
+         TAO_PEGTL_TEST_ASSERT( q.line == 1 );
+         TAO_PEGTL_TEST_ASSERT( q.column == 1 );
+      }
+
+      {
+         memory_input< tracking_mode::eager, eol::cr > in( "a\rc", "input" );
+         const auto r = parse_tree::parse_flat< G, selector >( in );
+         TAO_PEGTL_TEST_ASSERT( r );
+         const auto p = r->begin( ( *r )[ children( *r, r->root() ).back() ] );
+         TAO_PEGTL_TEST_ASSERT( p.byte == 2 );
+         TAO_PEGTL_TEST_ASSERT( p.line == 2 );
+         TAO_PEGTL_TEST_ASSERT( p.column == 1 );
+      }
+
+      {
+         const char* data = "xa\nc";
+         memory_input in( data + 1, data + 4, "input", 10, 3, 5 );
+         const auto r = parse_tree::parse_flat< G, selector >( in );
+         TAO_PEGTL_TEST_ASSERT( r );
+         const auto c = children( *r, r->root() );
+         const auto q = r->end( ( *r )[ c.front() ] );
+         TAO_PEGTL_TEST_ASSERT( q.byte == 11 );
+         TAO_PEGTL_TEST_ASSERT( q.line == 3 );
+         TAO_PEGTL_TEST_ASSERT( q.column == 6 );
+         const auto p = r->begin( ( *r )[ c.back() ] );
+         TAO_PEGTL_TEST_ASSERT( p.byte == 12 );
+         TAO_PEGTL_TEST_ASSERT( p.line == 4 );
+         TAO_PEGTL_TEST_ASSERT( p.column == 1 );
+      }
+
+      {
+         const std::string data( 1000, 'a' );
+         memory_input in( data, "input" );
+         const auto r = parse_tree::parse_flat< star< A > >( in );
+         TAO_PEGTL_TEST_ASSERT( r );
+         TAO_PEGTL_TEST_ASSERT( r->nodes.size() == 1002 );
+         const auto c = children( *r, r->root() );
+         TAO_PEGTL_TEST_ASSERT( c.size() == 1 );
+         const auto ac = children( *r, ( *r )[ c.front() ] );
+         TAO_PEGTL_TEST_ASSERT( ac.size() == 1000 );
+         for( std::size_t i = 0; i < ac.size(); ++i ) {
+            TAO_PEGTL_TEST_ASSERT( r->is_type< A >( ( *r )[ ac[ i ] ] ) );
+            TAO_PEGTL_TEST_ASSERT( ( *r )[ ac[ i ] ].begin == i );
+         }
+      }
+   }
+
+}  // namespace tao::pegtl
+
+#include "main.hpp"
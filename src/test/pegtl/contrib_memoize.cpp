@@ -0,0 +1,182 @@
+// Copyright (c) 2023 Dr. Colin Hirsch and Daniel Frey
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+#include <type_traits>
+
+#include <tao/pegtl/contrib/input_with_memo.hpp>
+#include <tao/pegtl/contrib/memoize.hpp>
+
+#include "test.hpp"
+
+namespace tao::pegtl
+{
+   std::size_t expr_starts = 0;
+   std::size_t failing_starts = 0;
+   std::size_t alpha_applies = 0;
+
+   struct test_expr
+      : plus< sor< alpha, eol > >
+   {};
+
+   struct test_grammar
+      : seq< sor< seq< test_expr, one< '1' > >, seq< test_expr, one< '2' > >, seq< test_expr, one< '3' > > >, eof >
+   {};
+
+   struct test_failing
+      : seq< test_grammar >
+   {};
+
+   struct test_retry
+      : sor< seq< test_failing, one< 'x' > >, seq< test_failing, one< 'y' > >, any >
+   {};
+
+   template< typename Rule >
+   struct test_action
+      : nothing< Rule >
+   {};
+
+   template<>
+   struct test_action< test_expr >
+      : memoize
+   {};
+
+   template<>
+   struct test_action< test_failing >
+      : memoize
+   {};
+
+   template< typename Rule >
+   struct alpha_action
+      : test_action< Rule >
+   {};
+
+   template<>
+   struct alpha_action< alpha >
+   {
+      static void apply0()
+      {
+         ++alpha_applies;
+      }
+   };
+
+   struct test_reject
+      : seq< alpha >
+   {};
+
+   struct test_lookahead
+      : sor< seq< test_reject, one< 'x' > >, seq< at< test_reject >, alpha, eof > >
+   {};
+
+   template< typename Rule >
+   struct reject_action
+      : nothing< Rule >
+   {};
+
+   template<>
+   struct reject_action< test_reject >
+      : memoize
+   {
+      static bool apply0()
+      {
+         return false;
+      }
+   };
+
+   template< typename Rule >
+   struct test_control
+      : normal< Rule >
+   {
+      template< typename ParseInput, typename... States >
+      static void start( const ParseInput& /*unused*/, States&&... /*unused*/ ) noexcept
+      {
+         if constexpr( std::is_same_v< Rule, test_expr > ) {
+            ++expr_starts;
+         }
+         if constexpr( std::is_same_v< Rule, test_failing > ) {
+            ++failing_starts;
+         }
+      }
+   };
+
+   template< typename Input >
+   void test_input()
+   {
+      using memory_input_with_memo = input_with_memo< Input >;
+
+      expr_starts = 0;
+      memory_input_with_memo i1( "ab\ncd3", __FUNCTION__ );
+      const auto r1 = pegtl::parse< test_grammar, nothing, test_control >( i1 );
+      TAO_PEGTL_TEST_ASSERT( r1 );
+      TAO_PEGTL_TEST_ASSERT( expr_starts == 3 );
+
+      expr_starts = 0;
+      memory_input_with_memo i2( "ab\ncd3", __FUNCTION__ );
+      const auto r2 = pegtl::parse< test_grammar, test_action, test_control, apply_mode::nothing >( i2 );
+      TAO_PEGTL_TEST_ASSERT( r2 );
+      TAO_PEGTL_TEST_ASSERT( expr_starts == 1 );
+      TAO_PEGTL_TEST_ASSERT( i2.byte() == 6 );
+      TAO_PEGTL_TEST_ASSERT( i2.position().line == 2 );
+      TAO_PEGTL_TEST_ASSERT( i2.position().column == 4 );
+
+      expr_starts = 0;
+      memory_input_with_memo i3( "ab\ncd3", __FUNCTION__ );
+      const auto r3 = pegtl::parse< test_grammar, test_action, test_control >( i3 );
+      TAO_PEGTL_TEST_ASSERT( r3 );
+      TAO_PEGTL_TEST_ASSERT( expr_starts == 1 );
+      TAO_PEGTL_TEST_ASSERT( i3.byte() == 6 );
+
+      expr_starts = 0;
+      alpha_applies = 0;
+      memory_input_with_memo i8( "ab\ncd3", __FUNCTION__ );
+      const auto r8 = pegtl::parse< test_grammar, alpha_action, test_control >( i8 );
+      TAO_PEGTL_TEST_ASSERT( r8 );
+      TAO_PEGTL_TEST_ASSERT( expr_starts == 3 );
+      TAO_PEGTL_TEST_ASSERT( alpha_applies == 12 );
+
+      memory_input_with_memo i9( "a", __FUNCTION__ );
+      const auto r9 = pegtl::parse< test_lookahead, reject_action >( i9 );
+      TAO_PEGTL_TEST_ASSERT( r9 );
+
+      expr_starts = 0;
+      memory_input_with_memo i4( "ab4", __FUNCTION__ );
+      const auto r4 = pegtl::parse< test_grammar, test_action, test_control, apply_mode::nothing >( i4 );
+      TAO_PEGTL_TEST_ASSERT( !r4 );
+      TAO_PEGTL_TEST_ASSERT( expr_starts == 1 );
+
+      failing_starts = 0;
+      memory_input_with_memo i5( "ab4", __FUNCTION__ );
+      const auto r5 = pegtl::parse< test_retry, test_action, test_control >( i5 );
+      TAO_PEGTL_TEST_ASSERT( r5 );
+      TAO_PEGTL_TEST_ASSERT( failing_starts == 1 );
+      TAO_PEGTL_TEST_ASSERT( i5.byte() == 1 );
+
+      i5.restart();
+      failing_starts = 0;
+      const auto r6 = pegtl::parse< test_retry, test_action, test_control >( i5 );
+      TAO_PEGTL_TEST_ASSERT( r6 );
+      TAO_PEGTL_TEST_ASSERT( failing_starts == 0 );
+
+      i5.memo_clear();
+      i5.restart();
+      const auto r7 = pegtl::parse< test_retry, test_action, test_control >( i5 );
+      TAO_PEGTL_TEST_ASSERT( r7 );
+      TAO_PEGTL_TEST_ASSERT( failing_starts == 1 );
+
+      i5.restart();
+      failing_starts = 0;
+      i5.discard();
+      const auto r10 = pegtl::parse< test_retry, test_action, test_control >( i5 );
+      TAO_PEGTL_TEST_ASSERT( r10 );
+      TAO_PEGTL_TEST_ASSERT( failing_starts == 1 );
+   }
+
+   void unit_test()
+   {
+      test_input< memory_input<> >();
+      test_input< memory_input< tracking_mode::lazy > >();
+   }
+
+}  // namespace tao::pegtl
+
+#include "main.hpp"
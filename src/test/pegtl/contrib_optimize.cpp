@@ -0,0 +1,120 @@
+// Copyright (c) 2023 Dr. Colin Hirsch and Daniel Frey
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+#include <string>
+#include <type_traits>
+
+#include "test.hpp"
+#include "verify_rule.hpp"
+
+#include <tao/pegtl/contrib/optimize.hpp>
+
+namespace tao::pegtl
+{
+   struct named
+      : seq< one< 'a' >, one< 'b' > >
+   {};
+
+   using grammar = seq< opt< star< sor< one< 'x' >, one< 'y' > > > >, seq< string< 'a', 'b' >, one< 'c' >, named >, rep< 3, one< '-' > >, eof >;
+
+   std::string applied;
+
+   template< typename Rule >
+   struct my_action
+   {};
+
+   template<>
+   struct my_action< named >
+   {
+      template< typename ActionInput >
+      static void apply( const ActionInput& in )
+      {
+         applied += in.string();
+      }
+   };
+
+   template< typename Rule >
+   struct anon_action
+      : nothing< Rule >
+   {};
+
+   template<>
+   struct anon_action< plus< alpha > >
+   {
+      template< typename ActionInput >
+      static void apply( const ActionInput& in )
+      {
+         applied += in.string();
+      }
+   };
+
+   template<>
+   struct anon_action< one< 'b' > >
+      : anon_action< plus< alpha > >
+   {};
+
+   template<>
+   struct anon_action< seq< digit, digit > >
+      : anon_action< plus< alpha > >
+   {};
+
+   using anon_grammar = seq< opt< plus< alpha > >, one< ',' >, seq< one< 'a' >, one< 'b' >, one< 'c' > >, seq< seq< digit, digit > >, eof >;
+
+   void unit_test()
+   {
+      static_assert( std::is_same_v< optimize< named >, named > );
+      static_assert( std::is_same_v< optimize< any >, any > );
+      static_assert( std::is_same_v< optimize< seq<> >, seq<> > );
+      static_assert( std::is_same_v< optimize< seq< any > >, any > );
+      static_assert( std::is_same_v< optimize< seq< alpha, seq< digit, seq< space > >, seq<> > >, seq< alpha, digit, space > > );
+      static_assert( std::is_same_v< optimize< sor< alpha, sor< digit, sor< space > >, sor<> > >, sor< alpha, digit, space > > );
+      static_assert( std::is_same_v< optimize< seq< one< 'a' >, string< 'b', 'c' >, one< 'd' > > >, string< 'a', 'b', 'c', 'd' > > );
+      static_assert( std::is_same_v< optimize< seq< one< 'a' >, named, one< 'b' >, one< 'c' > > >, seq< one< 'a' >, named, string< 'b', 'c' > > > );
+      static_assert( std::is_same_v< optimize< seq< one< 'a', 'b' >, one< 'c' > > >, seq< one< 'a', 'b' >, one< 'c' > > > );
+      static_assert( std::is_same_v< optimize< seq< istring< 'a' >, istring< 'b' > > >, istring< 'a', 'b' > > );
+      static_assert( std::is_same_v< optimize< seq< istring< 'a' >, string< 'b' > > >, seq< istring< 'a' >, string< 'b' > > > );
+      static_assert( std::is_same_v< optimize< sor< one< 'a' >, one< 'b', 'c' >, sor< one< 'd' > > > >, one< 'a', 'b', 'c', 'd' > > );
+      static_assert( std::is_same_v< optimize< sor< one< 'a' >, named, one< 'b' > > >, sor< one< 'a' >, named, one< 'b' > > > );
+      static_assert( std::is_same_v< optimize< opt< star< alpha > > >, star< alpha > > );
+      static_assert( std::is_same_v< optimize< opt< plus< alpha > > >, star< alpha > > );
+      static_assert( std::is_same_v< optimize< opt< opt< alpha > > >, opt< alpha > > );
+      static_assert( std::is_same_v< optimize< opt< alpha > >, opt< alpha > > );
+      static_assert( std::is_same_v< optimize< opt< alpha, digit > >, opt< alpha, digit > > );
+      static_assert( std::is_same_v< optimize< rep< 3, one< 'x' > > >, string< 'x', 'x', 'x' > > );
+      static_assert( std::is_same_v< optimize< rep< 2, string< 'a', 'b' > > >, string< 'a', 'b', 'a', 'b' > > );
+      static_assert( std::is_same_v< optimize< rep< 2, seq< one< 'a' >, one< 'b' > > > >, string< 'a', 'b', 'a', 'b' > > );
+      static_assert( std::is_same_v< optimize< rep< 100, one< 'x' > > >, rep< 100, one< 'x' > > > );
+      static_assert( std::is_same_v< optimize< rep< 2, one< 'x', 'y' > > >, rep< 2, one< 'x', 'y' > > > );
+      static_assert( std::is_same_v< optimize< plus< seq< seq< alpha > > > >, plus< alpha > > );
+      static_assert( std::is_same_v< optimize< not_at< sor< one< 'a' >, one< 'b' > > > >, not_at< one< 'a', 'b' > > > );
+      static_assert( std::is_same_v< optimize< grammar >, seq< star< one< 'x', 'y' > >, string< 'a', 'b', 'c' >, named, string< '-', '-', '-' >, eof > > );
+
+      verify_rule< optimize< grammar > >( __LINE__, __FILE__, "abcab---", result_type::success, 0 );
+      verify_rule< optimize< grammar > >( __LINE__, __FILE__, "xyyxabcab---", result_type::success, 0 );
+      verify_rule< optimize< grammar > >( __LINE__, __FILE__, "abcab--", result_type::local_failure, 7 );
+      verify_rule< optimize< grammar > >( __LINE__, __FILE__, "abab---", result_type::local_failure, 7 );
+      verify_rule< optimize< grammar > >( __LINE__, __FILE__, "xzabcab---", result_type::local_failure, 10 );
+
+      static_assert( std::is_same_v< optimize< opt< plus< alpha > >, anon_action >, opt< plus< alpha > > > );
+      static_assert( std::is_same_v< optimize< opt< plus< digit > >, anon_action >, star< digit > > );
+      static_assert( std::is_same_v< optimize< seq< one< 'a' >, one< 'b' >, one< 'c' >, one< 'd' > >, anon_action >, seq< one< 'a' >, one< 'b' >, string< 'c', 'd' > > > );
+      static_assert( std::is_same_v< optimize< sor< one< 'a' >, one< 'b' >, one< 'c' >, one< 'd' > >, anon_action >, sor< one< 'a' >, one< 'b' >, one< 'c', 'd' > > > );
+      static_assert( std::is_same_v< optimize< seq< alpha, seq< digit, digit > >, anon_action >, seq< alpha, seq< digit, digit > > > );
+      static_assert( std::is_same_v< optimize< seq< seq< digit, digit > >, anon_action >, seq< digit, digit > > );
+      static_assert( std::is_same_v< optimize< rep< 2, one< 'b' > >, anon_action >, rep< 2, one< 'b' > > > );
+      static_assert( std::is_same_v< optimize< anon_grammar, anon_action >, seq< opt< plus< alpha > >, string< ',', 'a' >, one< 'b' >, one< 'c' >, seq< digit, digit >, eof > > );
+
+      memory_input in( "xabcab---", __FUNCTION__ );
+      TAO_PEGTL_TEST_ASSERT( parse< optimize< grammar >, my_action >( in ) );
+      TAO_PEGTL_TEST_ASSERT( applied == "ab" );
+
+      applied.clear();
+      memory_input in2( "xy,abc12", __FUNCTION__ );
+      TAO_PEGTL_TEST_ASSERT( parse< optimize< anon_grammar, anon_action >, anon_action >( in2 ) );
+      TAO_PEGTL_TEST_ASSERT( applied == "xyb12" );
+   }
+
+}  // namespace tao::pegtl
+
+#include "main.hpp"
@@ -0,0 +1,114 @@
+// Copyright (c) 2023 Dr. Colin Hirsch and Daniel Frey
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+#include <string>
+
+#include "test.hpp"
+
+#include <tao/pegtl/contrib/parallel_parse.hpp>
+
+namespace tao::pegtl
+{
+   struct test_state
+   {
+      std::size_t records = 0;
+      std::size_t sum = 0;
+      std::size_t mismatches = 0;
+   };
+
+   struct test_number
+      : plus< digit >
+   {};
+
+   struct test_record
+      : seq< test_number, one< ',' >, test_number, eol >
+   {};
+
+   struct test_failing
+      : seq< test_number, one< ',' >, must< test_number >, eol >
+   {};
+
+   template< typename Rule >
+   struct test_action
+      : nothing< Rule >
+   {};
+
+   template<>
+   struct test_action< test_record >
+   {
+      template< typename ActionInput >
+      static void apply( const ActionInput& in, test_state& st )
+      {
+         const auto p = in.position();
+         const auto line = std::stoul( in.string() );
+         const auto value = std::stoul( in.string().substr( in.string().find( ',' ) + 1 ) );
+         ++st.records;
+         st.sum += value;
+         st.mismatches += ( p.line != line ) || ( p.column != 1 ) || ( value != 3 * line ) || ( p.source != "data" );
+      }
+   };
+
+   void reduce( test_state& total, test_state&& part )
+   {
+      total.records += part.records;
+      total.sum += part.sum;
+      total.mismatches += part.mismatches;
+   }
+
+   template< tracking_mode P >
+   void test_tracking( const std::string& data, const std::size_t lines )
+   {
+      for( const std::size_t threads : { 1, 2, 4 } ) {
+         test_state st;
+         memory_input< P > in( data, "data" );
+         TAO_PEGTL_TEST_ASSERT( parallel_parse< test_record, eol, test_action >( in, st, reduce, threads, 1000 ) );
+         TAO_PEGTL_TEST_ASSERT( st.records == lines );
+         TAO_PEGTL_TEST_ASSERT( st.sum == 3 * lines * ( lines + 1 ) / 2 );
+         TAO_PEGTL_TEST_ASSERT( st.mismatches == 0 );
+         TAO_PEGTL_TEST_ASSERT( in.empty() );
+         TAO_PEGTL_TEST_ASSERT( in.byte() == data.size() );
+         TAO_PEGTL_TEST_ASSERT( in.position().line == lines + 1 );
+         TAO_PEGTL_TEST_ASSERT( in.position().column == 1 );
+      }
+   }
+
+   void unit_test()
+   {
+      std::string data;
+      const std::size_t lines = 20000;
+      for( std::size_t i = 1; i <= lines; ++i ) {
+         data += std::to_string( i ) + ',' + std::to_string( 3 * i ) + '\n';
+      }
+      test_tracking< tracking_mode::eager >( data, lines );
+      test_tracking< tracking_mode::lazy >( data, lines );
+
+      test_state s0;
+      memory_input<> i0( "", "data" );
+      TAO_PEGTL_TEST_ASSERT( parallel_parse< test_record, eol, test_action >( i0, s0, reduce, 4, 1 ) );
+      TAO_PEGTL_TEST_ASSERT( s0.records == 0 );
+
+      test_state s1;
+      const std::string broken = data + "1,x\n" + data;
+      memory_input<> i1( broken, "data" );
+      TAO_PEGTL_TEST_ASSERT( !parallel_parse< test_record, eol, test_action >( i1, s1, reduce, 4, 1000 ) );
+      TAO_PEGTL_TEST_ASSERT( s1.records == 0 );
+      TAO_PEGTL_TEST_ASSERT( i1.byte() == 0 );
+
+#if defined( __cpp_exceptions )
+      test_state s2;
+      memory_input<> i2( broken, "data" );
+      try {
+         (void)parallel_parse< test_failing, eol >( i2, s2, reduce, 4, 1000 );
+         TAO_PEGTL_TEST_UNREACHABLE;  // LCOV_EXCL_LINE
+      }
+      catch( const parse_error& e ) {
+         TAO_PEGTL_TEST_ASSERT( e.positions().front().line == lines + 1 );
+         TAO_PEGTL_TEST_ASSERT( e.positions().front().column == 3 );
+      }
+#endif
+   }
+
+}  // namespace tao::pegtl
+
+#include "main.hpp"
@@ -0,0 +1,174 @@
+// Copyright (c) 2023 Dr. Colin Hirsch and Daniel Frey
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+#include <cstddef>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "test.hpp"
+
+#include <tao/pegtl/contrib/json.hpp>
+#include <tao/pegtl/contrib/parse_events.hpp>
+
+namespace tao::pegtl
+{
+   // clang-format off
+   struct A : one< 'a' > {};
+   struct B : one< 'b' > {};
+   struct C : one< 'c' > {};
+
+   struct D : sor< seq< A, B >, seq< A, C > > {};
+   struct E : seq< D, star< one< ',' >, D > > {};
+   struct F : seq< A, not_at< seq< B, C > >, opt< B > > {};
+   struct R : seq< plus< digit >, eol > {};
+   struct G : seq< star< R >, eof > {};
+#if defined( __cpp_exceptions )
+   struct H : sor< try_catch< seq< A, B, must< C > > >, seq< A, B > > {};
+#endif
+   // clang-format on
+
+   template< typename Rule >
+   using selector = parse_tree::selector< Rule,
+                                          parse_tree::store_content::on< A, B, C, D, R > >;
+
+   struct recorder
+   {
+      std::vector< parse_tree::event > events;
+
+      void operator()( const parse_tree::event& e )
+      {
+         events.push_back( e );
+      }
+   };
+
+   template< typename Rule >
+   using json_selector = parse_tree::selector< Rule,
+                                               parse_tree::store_content::on< json::number, json::array > >;
+
+   template< typename Grammar, typename Rule >
+   [[nodiscard]] bool is( const parse_tree::event& e, const parse_tree::event_type t, const std::size_t begin, const std::size_t end )
+   {
+      return ( e.rule == rule_id_v< Grammar, Rule > ) && ( e.type == t ) && ( e.begin == begin ) && ( e.end == end );
+   }
+
+   void unit_test()
+   {
+      using parse_tree::event_type;
+      {
+         memory_input in( "ac", __FUNCTION__ );
+         recorder r;
+         TAO_PEGTL_TEST_ASSERT( parse_tree::parse_events< D, selector >( in, r ) );
+         // The token for the A of the failed first alternative is retracted.
+         TAO_PEGTL_TEST_ASSERT( r.events.size() == 6 );
+         TAO_PEGTL_TEST_ASSERT( ( is< D, D >( r.events[ 0 ], event_type::enter, 0, 0 ) ) );
+         TAO_PEGTL_TEST_ASSERT( ( is< D, A >( r.events[ 1 ], event_type::token, 0, 1 ) ) );
+         TAO_PEGTL_TEST_ASSERT( ( is< D, seq< A, B > >( r.events[ 2 ], event_type::rollback, 1, 1 ) ) );
+         TAO_PEGTL_TEST_ASSERT( ( is< D, A >( r.events[ 3 ], event_type::token, 0, 1 ) ) );
+         TAO_PEGTL_TEST_ASSERT( ( is< D, C >( r.events[ 4 ], event_type::token, 1, 2 ) ) );
+         TAO_PEGTL_TEST_ASSERT( ( is< D, D >( r.events[ 5 ], event_type::leave, 0, 2 ) ) );
+      }
+      {
+         memory_input in( "ab,ac,x", __FUNCTION__ );
+         recorder r;
+         TAO_PEGTL_TEST_ASSERT( parse_tree::parse_events< E, selector >( in, r ) );
+         TAO_PEGTL_TEST_ASSERT( r.events.size() == 12 );
+         TAO_PEGTL_TEST_ASSERT( ( is< E, D >( r.events[ 4 ], event_type::enter, 3, 3 ) ) );
+         TAO_PEGTL_TEST_ASSERT( ( is< E, seq< A, B > >( r.events[ 6 ], event_type::rollback, 5, 5 ) ) );
+         TAO_PEGTL_TEST_ASSERT( ( is< E, D >( r.events[ 9 ], event_type::leave, 3, 5 ) ) );
+         TAO_PEGTL_TEST_ASSERT( ( is< E, D >( r.events[ 10 ], event_type::enter, 6, 6 ) ) );
+         TAO_PEGTL_TEST_ASSERT( ( is< E, D >( r.events[ 11 ], event_type::rollback, 8, 8 ) ) );
+      }
+      {
+         memory_input in( "ab", __FUNCTION__ );
+         recorder r;
+         TAO_PEGTL_TEST_ASSERT( parse_tree::parse_events< F, selector >( in, r ) );
+         TAO_PEGTL_TEST_ASSERT( r.events.size() == 4 );
+         TAO_PEGTL_TEST_ASSERT( ( is< F, A >( r.events[ 0 ], event_type::token, 0, 1 ) ) );
+         TAO_PEGTL_TEST_ASSERT( ( is< F, B >( r.events[ 1 ], event_type::token, 1, 2 ) ) );
+         TAO_PEGTL_TEST_ASSERT( ( is< F, seq< B, C > >( r.events[ 2 ], event_type::rollback, 1, 1 ) ) );
+         TAO_PEGTL_TEST_ASSERT( ( is< F, B >( r.events[ 3 ], event_type::token, 1, 2 ) ) );
+      }
+      {
+         memory_input in( "x", __FUNCTION__ );
+         recorder r;
+         TAO_PEGTL_TEST_ASSERT( !parse_tree::parse_events< D, selector >( in, r ) );
+         // When the parsing run fails there is no leave for an enter that was already passed on.
+         TAO_PEGTL_TEST_ASSERT( r.events.size() == 1 );
+         TAO_PEGTL_TEST_ASSERT( ( is< D, D >( r.events[ 0 ], event_type::enter, 0, 0 ) ) );
+      }
+      {
+         // Every record is passed to the sink as soon as it was matched.
+         memory_input in( "1\n22\n333\n", __FUNCTION__ );
+         std::vector< std::size_t > sizes;
+         const auto sink = [ & ]( const parse_tree::event& e ) {
+            sizes.push_back( std::size_t( in.current() - in.begin() ) );
+            TAO_PEGTL_TEST_ASSERT( ( is< G, R >( e, event_type::token, e.begin, e.end ) ) );
+         };
+         TAO_PEGTL_TEST_ASSERT( parse_tree::parse_events< G, selector >( in, sink ) );
+         TAO_PEGTL_TEST_ASSERT( sizes.size() == 3 );
+         TAO_PEGTL_TEST_ASSERT( sizes[ 0 ] == 2 );
+         TAO_PEGTL_TEST_ASSERT( sizes[ 1 ] == 5 );
+         TAO_PEGTL_TEST_ASSERT( sizes[ 2 ] == 9 );
+      }
+#if defined( __cpp_exceptions )
+      {
+         // The rollback for the exception caught by try_catch is generated with the next event.
+         memory_input in( "ab", __FUNCTION__ );
+         recorder r;
+         TAO_PEGTL_TEST_ASSERT( parse_tree::parse_events< H, selector >( in, r ) );
+         TAO_PEGTL_TEST_ASSERT( r.events.size() == 5 );
+         TAO_PEGTL_TEST_ASSERT( r.events[ 2 ].type == event_type::rollback );
+         TAO_PEGTL_TEST_ASSERT( r.events[ 2 ].begin == 0 );
+         TAO_PEGTL_TEST_ASSERT( ( is< H, A >( r.events[ 3 ], event_type::token, 0, 1 ) ) );
+         TAO_PEGTL_TEST_ASSERT( ( is< H, B >( r.events[ 4 ], event_type::token, 1, 2 ) ) );
+      }
+#endif
+      {
+         // Events for the elements of a sor-based container are passed on while parsing.
+         std::string data = "[";
+         for( std::size_t i = 0; i < 10000; ++i ) {
+            data += std::to_string( i ) + ( ( i < 9999 ) ? "," : "]" );
+         }
+         memory_input in( data, __FUNCTION__ );
+         std::size_t numbers = 0;
+         const auto sink = [ & ]( const parse_tree::event& e ) {
+            TAO_PEGTL_TEST_ASSERT( e.type != event_type::rollback );
+            if( e.type == event_type::token ) {
+               TAO_PEGTL_TEST_ASSERT( ( is< json::text, json::number >( e, event_type::token, e.begin, e.end ) ) );
+               TAO_PEGTL_TEST_ASSERT( e.end == std::size_t( in.current() - in.begin() ) );
+               TAO_PEGTL_TEST_ASSERT( data.substr( e.begin, e.end - e.begin ) == std::to_string( numbers++ ) );
+            }
+         };
+         TAO_PEGTL_TEST_ASSERT( parse_tree::parse_events< json::text, json_selector >( in, sink ) );
+         TAO_PEGTL_TEST_ASSERT( numbers == 10000 );
+      }
+      {
+         std::string data;
+         for( std::size_t i = 0; i < 1000; ++i ) {
+            data += std::to_string( i ) + '\n';
+         }
+         parse_tree::event_ring< 16 > ring;
+         std::vector< parse_tree::event > events;
+         std::thread consumer( [ & ] {
+            parse_tree::event e;
+            while( ring.pop( e ) ) {
+               events.push_back( e );
+            }
+         } );
+         memory_input in( data, __FUNCTION__ );
+         const bool result = parse_tree::parse_events< G, selector >( in, ring );
+         ring.close();
+         consumer.join();
+         TAO_PEGTL_TEST_ASSERT( result );
+         TAO_PEGTL_TEST_ASSERT( events.size() == 1000 );
+         for( std::size_t i = 0; i < events.size(); ++i ) {
+            TAO_PEGTL_TEST_ASSERT( data.substr( events[ i ].begin, events[ i ].end - events[ i ].begin ) == std::to_string( i ) + '\n' );
+         }
+      }
+   }
+
+}  // namespace tao::pegtl
+
+#include "main.hpp"
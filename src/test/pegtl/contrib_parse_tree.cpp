@@ -2,6 +2,10 @@
 // Distributed under the Boost Software License, Version 1.0.
 // (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
 
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
 #include "test.hpp"
 
 #include <tao/pegtl/contrib/parse_tree.hpp>
@@ -37,6 +41,40 @@ namespace tao::pegtl
                                            parse_tree::discard_empty::on< F >,
                                            parse_tree::fold_one::on< E > >;
 
+   struct counted_node
+      : parse_tree::basic_node< counted_node >
+   {
+      static std::size_t count;
+
+      counted_node()
+      {
+         ++count;
+      }
+   };
+
+   std::size_t counted_node::count = 0;
+
+   struct destroyed_node
+      : parse_tree::basic_arena_node< destroyed_node >
+   {
+      static std::size_t count;
+
+      using basic_arena_node::basic_arena_node;
+
+      destroyed_node( const destroyed_node& ) = delete;
+      destroyed_node( destroyed_node&& ) = delete;
+
+      ~destroyed_node()
+      {
+         ++count;
+      }
+
+      destroyed_node& operator=( const destroyed_node& ) = delete;
+      destroyed_node& operator=( destroyed_node&& ) = delete;
+   };
+
+   std::size_t destroyed_node::count = 0;
+
    void unit_test()
    {
       {
@@ -147,6 +185,65 @@ namespace tao::pegtl
          TAO_PEGTL_TEST_ASSERT( internal->children.front()->is_type< A >() );
          TAO_PEGTL_TEST_ASSERT( internal->children.back()->is_type< C >() );
       }
+
+      {
+         // Only the root and the selected rules create nodes, including the A and B of the failed seq< A, B >.
+         memory_input in( "ac", "input" );
+         const auto r = parse_tree::parse< D, counted_node, selector >( in );
+         TAO_PEGTL_TEST_ASSERT( r );
+         TAO_PEGTL_TEST_ASSERT( counted_node::count == 6 );
+         TAO_PEGTL_TEST_ASSERT( r->children.size() == 1 );
+         TAO_PEGTL_TEST_ASSERT( r->children.front()->children.size() == 2 );
+      }
+
+      {
+         parse_tree::node_arena arena( 64 );
+         memory_input in( "ac", "input" );
+         const auto r = parse_tree::parse< D, parse_tree::arena_node, selector >( arena, in );
+         TAO_PEGTL_TEST_ASSERT( r );
+         TAO_PEGTL_TEST_ASSERT( r->is_root() );
+         TAO_PEGTL_TEST_ASSERT( r->children.size() == 1 );
+
+         const auto& d = r->children.front();
+         TAO_PEGTL_TEST_ASSERT( d->is_type< D >() );
+         TAO_PEGTL_TEST_ASSERT( d->children.size() == 2 );
+         TAO_PEGTL_TEST_ASSERT( d->children.front()->is_type< A >() );
+         TAO_PEGTL_TEST_ASSERT( d->children.front()->string_view() == "a" );
+         TAO_PEGTL_TEST_ASSERT( d->children.back()->is_type< C >() );
+         TAO_PEGTL_TEST_ASSERT( !d->children.back()->has_content() );
+
+         memory_input in2( "x", "input" );
+         TAO_PEGTL_TEST_ASSERT( !parse_tree::parse< D, parse_tree::arena_node, selector >( arena, in2 ) );
+      }
+
+      {
+         parse_tree::node_arena arena( 64 );
+         const std::string data( 1000, 'a' );
+         memory_input in( data, "input" );
+         const auto* r = parse_tree::parse< star< A >, parse_tree::arena_node >( arena, in );
+         TAO_PEGTL_TEST_ASSERT( r );
+         TAO_PEGTL_TEST_ASSERT( r->children.size() == 1 );
+         TAO_PEGTL_TEST_ASSERT( r->children.front()->children.size() == 1000 );
+         for( const auto& c : r->children.front()->children ) {
+            TAO_PEGTL_TEST_ASSERT( c->is_type< A >() );
+            TAO_PEGTL_TEST_ASSERT( reinterpret_cast< std::uintptr_t >( c.get() ) % alignof( parse_tree::arena_node ) == 0 );
+         }
+         arena.release();
+      }
+
+      {
+         // Only the node of the final failed attempt to match A is discarded and
+         // destroyed, the nodes of the returned tree are never destroyed.
+         parse_tree::node_arena arena( 64 );
+         memory_input in( "aaa", "input" );
+         destroyed_node::count = 0;
+         const auto* r = parse_tree::parse< star< A >, destroyed_node >( arena, in );
+         TAO_PEGTL_TEST_ASSERT( r );
+         TAO_PEGTL_TEST_ASSERT( r->children.front()->children.size() == 3 );
+         TAO_PEGTL_TEST_ASSERT( destroyed_node::count == 1 );
+         arena.release();
+         TAO_PEGTL_TEST_ASSERT( destroyed_node::count == 1 );
+      }
    }
 
 }  // namespace tao::pegtl
@@ -0,0 +1,85 @@
+// Copyright (c) 2023 Dr. Colin Hirsch and Daniel Frey
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+#include <string>
+
+#include "test.hpp"
+
+#include <tao/pegtl/contrib/push_parser.hpp>
+
+namespace tao::pegtl
+{
+   struct test_line
+      : seq< plus< digit >, eol >
+   {};
+
+   template< typename Rule >
+   struct test_action
+      : nothing< Rule >
+   {};
+
+   template<>
+   struct test_action< test_line >
+   {
+      template< typename ActionInput >
+      static void apply( const ActionInput& in, std::string& s )
+      {
+         s += in.string();
+      }
+   };
+
+   using test_grammar = until< eof, test_line, discard >;
+
+   void unit_test()
+   {
+      std::string data;
+      for( std::size_t i = 0; i < 5000; ++i ) {
+         data += std::to_string( i * 7919 ) + '\n';
+      }
+      std::string copy;
+      push_parser< test_grammar, test_action > p1( TAO_TEST_LINE, 100, copy );
+      std::size_t fed = 0;
+      for( std::size_t n = 1; fed < data.size(); n = n % 97 + 1 ) {
+         const std::size_t size = ( std::min )( n, data.size() - fed );
+         p1.feed( data.data() + fed, size );
+         fed += size;
+         const auto complete = data.rfind( '\n', fed - 2 );
+         TAO_PEGTL_TEST_ASSERT( data.compare( 0, copy.size(), copy ) == 0 );
+         TAO_PEGTL_TEST_ASSERT( ( fed < 2 ) || ( complete == std::string::npos ) || ( copy.size() > complete ) );
+         TAO_PEGTL_TEST_ASSERT( !p1.finished() );
+      }
+      TAO_PEGTL_TEST_ASSERT( p1.finish() );
+      TAO_PEGTL_TEST_ASSERT( p1.finished() );
+      TAO_PEGTL_TEST_ASSERT( copy == data );
+
+      push_parser< seq< string< 'a', 'b', 'c' >, eol > > p2( TAO_TEST_LINE, 100 );
+      p2.feed( "ab" );
+      TAO_PEGTL_TEST_ASSERT( !p2.finished() );
+      p2.feed( "c\n\nmore" );
+      TAO_PEGTL_TEST_ASSERT( p2.finished() );
+      p2.feed( "ignored" );
+      TAO_PEGTL_TEST_ASSERT( p2.finish() );
+
+      push_parser< seq< string< 'a', 'b', 'c' >, eof > > p3( TAO_TEST_LINE, 100 );
+      p3.feed( "abc" );
+      TAO_PEGTL_TEST_ASSERT( !p3.finished() );
+      p3.feed( "d" );
+      TAO_PEGTL_TEST_ASSERT( !p3.finish() );
+
+      {
+         push_parser< seq< string< 'a', 'b', 'c' >, eof > > p4( TAO_TEST_LINE, 100 );
+         p4.feed( "ab" );
+      }
+#if defined( __cpp_exceptions )
+      push_parser< must< string< 'a', 'b', 'c' >, eof > > p5( TAO_TEST_LINE, 100 );
+      p5.feed( "ab" );
+      p5.feed( "x" );
+      TAO_PEGTL_TEST_ASSERT( p5.finished() );
+      TAO_PEGTL_TEST_THROWS( p5.finish() );
+#endif
+   }
+
+}  // namespace tao::pegtl
+
+#include "main.hpp"
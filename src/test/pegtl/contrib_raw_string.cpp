@@ -76,6 +76,16 @@ namespace tao::pegtl
       }
    }
 
+   template< typename Rule >
+   void verify_long( const std::size_t line, const char* file, const std::string& m, const std::string& n, const std::size_t l, const std::size_t c )
+   {
+      content.clear();
+      memory_input in( m, file );
+      if( ( !parse< Rule, raction >( in ) ) || ( content != n ) || ( in.position().line != l ) || ( in.position().column != c ) ) {
+         TAO_PEGTL_TEST_FAILED( "input data [ '" << m << "' ] expected content [ '" << n << "' ] but got [ '" << content << "' ] at " << in.position() );  // LCOV_EXCL_LINE
+      }
+   }
+
    void unit_test()
    {
       verify_analyze< rstring >( __LINE__, __FILE__, true, false );
@@ -97,6 +107,19 @@ namespace tao::pegtl
       verify_data< qgrammar, qaction >( __LINE__, __FILE__, "[===[\r\na1]===]", "a1" );
       verify_data< qgrammar, qaction >( __LINE__, __FILE__, "[===[a0a1a2a3]===]", "a0a1a2a3" );
 
+      static_assert( internal::until_skip_enabled< internal::at_raw_string_close< '=', ']' >, apply_mode::action, raction, normal, ascii::eol::lf_crlf >() );
+
+      {
+         std::string n;
+         for( std::size_t i = 0; i < 100; ++i ) {
+            n += "abc]=]==]x\n";
+         }
+         verify_long< rstring >( __LINE__, __FILE__, "[===[" + n + "]===]", n, 101, 6 );
+         verify_long< rstring >( __LINE__, __FILE__, "[===[" + n + "]===]]===]", n, 101, 6 );
+         verify_long< rstring >( __LINE__, __FILE__, "[===[\n" + n + "]===]", n, 102, 6 );
+         verify_long< rstring >( __LINE__, __FILE__, "[[" + n + "]]", n, 101, 3 );
+      }
+
       verify_fail< rgrammar >( __LINE__, __FILE__, "" );
       verify_fail< rgrammar >( __LINE__, __FILE__, "[" );
       verify_fail< rgrammar >( __LINE__, __FILE__, "[=" );
@@ -111,6 +134,7 @@ namespace tao::pegtl
       verify_fail< rgrammar >( __LINE__, __FILE__, "[-[]-]" );
       verify_fail< rgrammar >( __LINE__, __FILE__, "[===[]====]" );
       verify_fail< rgrammar >( __LINE__, __FILE__, "[====[]===]" );
+      verify_fail< rgrammar >( __LINE__, __FILE__, "[=[" + std::string( 100, ']' ) );
 
       verify_fail< qgrammar >( __LINE__, __FILE__, "" );
       verify_fail< qgrammar >( __LINE__, __FILE__, "[" );
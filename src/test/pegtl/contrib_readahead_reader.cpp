@@ -0,0 +1,117 @@
+// Copyright (c) 2023 Dr. Colin Hirsch and Daniel Frey
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+
+#if defined( __unix__ ) || ( defined( __APPLE__ ) && defined( __MACH__ ) )
+#include <unistd.h>
+
+#include <tao/pegtl/internal/fd_reader.hpp>
+#endif
+
+#include "test.hpp"
+
+#include <tao/pegtl/contrib/readahead_reader.hpp>
+#include <tao/pegtl/internal/cstring_reader.hpp>
+
+namespace tao::pegtl
+{
+   struct test_failing_reader
+      : internal::cstring_reader
+   {
+      using internal::cstring_reader::cstring_reader;
+
+      [[nodiscard]] std::size_t operator()( char* buffer, const std::size_t length )
+      {
+         if( const auto r = internal::cstring_reader::operator()( buffer, length ) ) {
+            return r;
+         }
+#if defined( __cpp_exceptions )
+         throw std::runtime_error( "test reader failure" );
+#else
+         return 0;
+#endif
+      }
+   };
+
+   struct test_line
+      : seq< plus< digit >, eol >
+   {};
+
+   template< typename Rule >
+   struct test_action
+      : nothing< Rule >
+   {};
+
+   template<>
+   struct test_action< test_line >
+   {
+      template< typename ActionInput >
+      static void apply( const ActionInput& in, std::string& s )
+      {
+         s += in.string();
+      }
+   };
+
+   using test_grammar = until< eof, test_line, discard >;
+
+   template< typename Reader >
+   void test_reader( const std::string& data )
+   {
+      std::string copy;
+      buffer_input< Reader > in( TAO_TEST_LINE, 100, data.c_str() );
+      TAO_PEGTL_TEST_ASSERT( parse< test_grammar, test_action >( in, copy ) );
+      TAO_PEGTL_TEST_ASSERT( copy == data );
+      TAO_PEGTL_TEST_ASSERT( in.line() == 10001 );
+   }
+
+   void unit_test()
+   {
+      std::string data;
+      for( std::size_t i = 0; i < 10000; ++i ) {
+         data += std::to_string( i * 7919 ) + '\n';
+      }
+      test_reader< readahead_reader< internal::cstring_reader > >( data );
+      test_reader< readahead_reader< internal::cstring_reader, 1, 1 > >( data );
+      test_reader< readahead_reader< internal::cstring_reader, 3, 7 > >( data );
+      test_reader< readahead_reader< internal::cstring_reader, 4, 1000 > >( data );
+
+      {
+         // Destruction while the worker is waiting for a free chunk.
+         buffer_input< readahead_reader< internal::cstring_reader, 2, 16 > > in( TAO_TEST_LINE, 100, data.c_str() );
+         TAO_PEGTL_TEST_ASSERT( parse< test_line >( in ) );
+      }
+#if defined( __cpp_exceptions )
+      {
+         std::string copy;
+         buffer_input< readahead_reader< test_failing_reader, 2, 16 > > in( TAO_TEST_LINE, 100, data.c_str() );
+         TAO_PEGTL_TEST_THROWS( parse< test_grammar, test_action >( in, copy ) );
+         TAO_PEGTL_TEST_ASSERT( copy.size() + 10 > data.size() );
+         TAO_PEGTL_TEST_ASSERT( data.compare( 0, copy.size(), copy ) == 0 );
+      }
+#endif
+#if defined( __unix__ ) || ( defined( __APPLE__ ) && defined( __MACH__ ) )
+      {
+         // Data that is available is returned without waiting for more while the pipe stays open.
+         int fds[ 2 ];
+         TAO_PEGTL_TEST_ASSERT( ::pipe( fds ) == 0 );
+         {
+            buffer_input< readahead_reader< internal::fd_reader > > in( TAO_TEST_LINE, 100, fds[ 0 ] );
+            TAO_PEGTL_TEST_ASSERT( ::write( fds[ 1 ], "12", 2 ) == 2 );
+            TAO_PEGTL_TEST_ASSERT( in.size( 1 ) == 2 );
+            TAO_PEGTL_TEST_ASSERT( ::write( fds[ 1 ], "34\n", 3 ) == 3 );
+            TAO_PEGTL_TEST_ASSERT( in.size( 3 ) == 5 );
+            TAO_PEGTL_TEST_ASSERT( std::string( in.current(), 5 ) == "1234\n" );
+            ::close( fds[ 1 ] );  // Lets the worker thread return so that the destructor can join it.
+         }
+         ::close( fds[ 0 ] );
+      }
+#endif
+   }
+
+}  // namespace tao::pegtl
+
+#include "main.hpp"
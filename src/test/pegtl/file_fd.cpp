@@ -0,0 +1,81 @@
+// Copyright (c) 2023 Dr. Colin Hirsch and Daniel Frey
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined( __unix__ ) && !( defined( __APPLE__ ) && defined( __MACH__ ) )
+#include <iostream>
+int main()
+{
+   std::cout << "File descriptor input not supported on this platform, skipping test..." << std::endl;
+}
+#else
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <string>
+
+#include "test.hpp"
+
+#include <tao/pegtl/fd_input.hpp>
+
+namespace tao::pegtl
+{
+   struct file_content
+      : seq< TAO_PEGTL_STRING( "dummy content" ), eol, discard >
+   {};
+
+   struct file_grammar
+      : seq< rep_min_max< 11, 11, file_content >, eof >
+   {};
+
+   struct pipe_grammar
+      : seq< star< string< 'a', 'b', 'c' >, eol, discard >, eof >
+   {};
+
+   // Returns each byte in a separate call to exercise repeated reads.
+
+   struct trickle_reader
+      : internal::fd_reader
+   {
+      using internal::fd_reader::fd_reader;
+
+      [[nodiscard]] std::size_t operator()( char* buffer, const std::size_t length ) const
+      {
+         return internal::fd_reader::operator()( buffer, ( length > 0 ) ? 1 : 0 );
+      }
+   };
+
+   void unit_test()
+   {
+      const char* const filename = "src/test/pegtl/file_data.txt";
+      const int fd = ::open( filename, O_RDONLY );
+      TAO_PEGTL_TEST_ASSERT( fd >= 0 );
+      TAO_PEGTL_TEST_ASSERT( parse< file_grammar >( fd_input( fd, 16, filename ) ) );
+      ::close( fd );
+
+      const int fd2 = ::open( filename, O_RDONLY );
+      TAO_PEGTL_TEST_ASSERT( fd2 >= 0 );
+      buffer_input< trickle_reader, eol::lf_crlf, std::string, 4 > in2( filename, 16, fd2 );
+      TAO_PEGTL_TEST_ASSERT( parse< file_grammar >( in2 ) );
+      ::close( fd2 );
+
+      int p[ 2 ];
+      TAO_PEGTL_TEST_ASSERT( ::pipe( p ) == 0 );
+      std::string data;
+      for( std::size_t i = 0; i < 1000; ++i ) {
+         data += "abc\n";
+      }
+      TAO_PEGTL_TEST_ASSERT( ::write( p[ 1 ], data.data(), data.size() ) == ssize_t( data.size() ) );
+      ::close( p[ 1 ] );
+      fd_input< eol::lf_crlf, 16 > in3( p[ 0 ], 16, "pipe" );
+      TAO_PEGTL_TEST_ASSERT( parse< pipe_grammar >( in3 ) );
+      TAO_PEGTL_TEST_ASSERT( in3.line() == 1001 );
+      ::close( p[ 0 ] );
+   }
+
+}  // namespace tao::pegtl
+
+#include "main.hpp"
+
+#endif
@@ -15,6 +15,16 @@ namespace tao::pegtl
    void unit_test()
    {
       verify_file< mmap_input<> >();
+
+      const mmap_options all = { true, true, true, true };
+      for( const auto& options : { mmap_options(), mmap_options{ true }, mmap_options{ false, true }, mmap_options{ false, false, true }, mmap_options{ false, false, false, true }, all } ) {
+         mmap_input<> in( "src/test/pegtl/file_data.txt", options );
+         TAO_PEGTL_TEST_ASSERT( in.source() == "src/test/pegtl/file_data.txt" );
+         TAO_PEGTL_TEST_ASSERT( parse< file_grammar >( in ) );
+      }
+      file_input<> in( "src/test/pegtl/file_data.txt", all, "source" );
+      TAO_PEGTL_TEST_ASSERT( in.source() == "source" );
+      TAO_PEGTL_TEST_ASSERT( parse< file_grammar >( in ) );
    }
 
 }  // namespace tao::pegtl
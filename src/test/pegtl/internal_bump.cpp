@@ -0,0 +1,73 @@
+// Copyright (c) 2023 Dr. Colin Hirsch and Daniel Frey
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+#include <cstddef>
+#include <string>
+
+#include "test.hpp"
+
+#include <tao/pegtl/internal/bump.hpp>
+
+namespace tao::pegtl
+{
+   void test_bump( const std::string& s, const std::size_t count )
+   {
+      internal::frobnicator a( s.data(), 3, 2, 5 );
+      internal::bump( a, count, '\n' );
+
+      internal::frobnicator b( s.data(), 3, 2, 5 );
+      for( std::size_t i = 0; i < count; ++i ) {
+         if( s[ i ] == '\n' ) {
+            ++b.line;
+            b.column = 1;
+         }
+         else {
+            ++b.column;
+         }
+      }
+      TAO_PEGTL_TEST_ASSERT( a.data == s.data() + count );
+      TAO_PEGTL_TEST_ASSERT( a.byte == 3 + count );
+      TAO_PEGTL_TEST_ASSERT( a.line == b.line );
+      TAO_PEGTL_TEST_ASSERT( a.column == b.column );
+
+      const auto r = internal::scan_lines( s.data(), count, '\n' );
+      const auto t = internal::scan_lines_scalar( s.data(), count, '\n' );
+      TAO_PEGTL_TEST_ASSERT( r.lines == t.lines );
+      TAO_PEGTL_TEST_ASSERT( r.last == t.last );
+   }
+
+   void unit_test()
+   {
+      std::string s;
+      for( std::size_t i = 0; i < 300; ++i ) {
+         s += ( ( i * 7 ) % 11 == 3 ) ? '\n' : char( 'a' + i % 26 );
+      }
+      for( std::size_t i = 0; i <= s.size(); ++i ) {
+         test_bump( s, i );
+      }
+      const std::string n( 100, '\n' );
+      for( std::size_t i = 0; i <= n.size(); ++i ) {
+         test_bump( n, i );
+      }
+      const std::string e( 100, 'x' );
+      for( std::size_t i = 0; i <= e.size(); ++i ) {
+         test_bump( e, i );
+      }
+      std::string h( 100, '\xa0' );
+      h[ 70 ] = '\n';
+      for( std::size_t i = 0; i <= h.size(); ++i ) {
+         test_bump( h, i );
+      }
+      std::string l( 20000, '\n' );
+      for( std::size_t i = 0; i < l.size(); i += 3 ) {
+         l[ i ] = 'y';
+      }
+      test_bump( l, l.size() );
+      test_bump( l, l.size() - 1 );
+      test_bump( l, 9999 );
+   }
+
+}  // namespace tao::pegtl
+
+#include "main.hpp"
@@ -0,0 +1,135 @@
+// Copyright (c) 2023 Dr. Colin Hirsch and Daniel Frey
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "test.hpp"
+
+#include <tao/pegtl/contrib/predicates.hpp>
+#include <tao/pegtl/contrib/uint8.hpp>
+
+namespace tao::pegtl
+{
+   template< typename Rule >
+   void test_char_class( const std::size_t line, const char* file )
+   {
+      using data_t = typename Rule::data_t;
+      for( std::size_t i = 0; i < 256; ++i ) {
+         const auto c = static_cast< data_t >( static_cast< unsigned char >( i ) );
+         if( Rule::test_one( c ) != Rule::test_compare( c ) ) {
+            TAO_PEGTL_TEST_FAILED( "char class mismatch for byte " << i );  // LCOV_EXCL_LINE
+         }
+      }
+   }
+
+   template< typename Rule >
+   void test_scan( const std::size_t line, const char* file, const std::string& data )
+   {
+      for( std::size_t b = 0; b < data.size(); ++b ) {
+         const std::size_t a = internal::scan_char_class< Rule >( data.data() + b, data.size() - b );
+         const std::size_t s = internal::scan_char_class_scalar< Rule >( data.data() + b, data.size() - b );
+         if( a != s ) {
+            TAO_PEGTL_TEST_FAILED( "char class scan mismatch at offset " << b );  // LCOV_EXCL_LINE
+         }
+      }
+   }
+
+   template< typename Rule >
+   void test_star( const std::size_t line, const char* file, const std::string& data, const std::size_t count, const std::size_t lines )
+   {
+      memory_input in( data, __FUNCTION__ );
+      if( !parse< seq< star< Rule >, star< any > > >( in ) ) {
+         TAO_PEGTL_TEST_FAILED( "star failed" );  // LCOV_EXCL_LINE
+      }
+      memory_input a( data, __FUNCTION__ );
+      if( parse< plus< Rule > >( a ) != ( count != 0 ) ) {
+         TAO_PEGTL_TEST_FAILED( "plus failed" );  // LCOV_EXCL_LINE
+      }
+      if( ( a.byte() != count ) || ( a.position().line != lines + 1 ) ) {
+         TAO_PEGTL_TEST_FAILED( "plus consumed " << a.byte() << " bytes and " << ( a.position().line - 1 ) << " lines" );  // LCOV_EXCL_LINE
+      }
+   }
+
+   template< typename Rule >
+   struct test_action
+      : nothing< Rule >
+   {};
+
+   template<>
+   struct test_action< digit >
+   {
+      static void apply0( std::size_t& count )
+      {
+         ++count;
+      }
+   };
+
+   void unit_test()
+   {
+      static_assert( internal::char_class_scan< digit, apply_mode::action, nothing, normal > );
+      static_assert( internal::char_class_scan< digit, apply_mode::nothing, test_action, normal > );
+      static_assert( !internal::char_class_scan< digit, apply_mode::action, test_action, normal > );
+      static_assert( internal::char_class_scan< alpha, apply_mode::action, test_action, normal > );
+
+      static_assert( internal::char_class_rule< xdigit > );
+      static_assert( internal::char_class_rule< any > );
+      static_assert( internal::char_class_rule< one< 'a' > > );
+      static_assert( !internal::char_class_rule< utf8::one< 'a' > > );
+      static_assert( !internal::char_class_rule< string< 'a', 'b' > > );
+      static_assert( !internal::char_class_rule< uint8::one< 1 > > );
+
+      static_assert( internal::char_class_peek< internal::peek_char > );
+      static_assert( internal::char_class_peek< internal::peek_uint8 > );
+      static_assert( !internal::char_class_peek< internal::peek_utf8 > );
+
+      static_assert( internal::char_class_v< xdigit >.test( 'a' ) );
+      static_assert( internal::char_class_v< xdigit >.test( 'F' ) );
+      static_assert( internal::char_class_v< xdigit >.test( '7' ) );
+      static_assert( !internal::char_class_v< xdigit >.test( 'g' ) );
+      static_assert( !internal::char_class_v< xdigit >.test( 0xff ) );
+
+      test_char_class< xdigit >( __LINE__, __FILE__ );
+      test_char_class< alnum >( __LINE__, __FILE__ );
+      test_char_class< space >( __LINE__, __FILE__ );
+      test_char_class< not_one< 'a', 'b', 'c', 'd', 'e' > >( __LINE__, __FILE__ );
+      test_char_class< one< '!', '$', '&', '\'', '(', ')', '*', '+', ',', ';', '=' > >( __LINE__, __FILE__ );
+      test_char_class< one< char( 0x80 ), char( 0xa0 ), char( 0xfe ), char( 0xff ) > >( __LINE__, __FILE__ );
+      test_char_class< ranges< 'a', 'z', char( 0x80 ), char( 0xbf ), '_' > >( __LINE__, __FILE__ );
+      test_char_class< predicates_or< alpha, digit, one< '-', '.', '_', '~' > > >( __LINE__, __FILE__ );
+      test_char_class< predicates_and< alnum, not_one< 'x' > > >( __LINE__, __FILE__ );
+      test_char_class< predicate_not< xdigit > >( __LINE__, __FILE__ );
+      test_char_class< uint8::one< 1, 2, 3, 4, 200 > >( __LINE__, __FILE__ );
+      test_char_class< uint8::not_one< 10, 20, 30, 250 > >( __LINE__, __FILE__ );
+      test_char_class< uint8::ranges< 1, 2, 100, 200, 255 > >( __LINE__, __FILE__ );
+
+      std::string data;
+      for( std::size_t i = 0; i < 300; ++i ) {
+         data += static_cast< char >( ( i * 37 ) & 0xff );
+         data += "0123456789abcdefABCDEF \n\t"[ i % 25 ];
+      }
+      test_scan< xdigit >( __LINE__, __FILE__, data );
+      test_scan< space >( __LINE__, __FILE__, data );
+      test_scan< not_one< 'x', char( 0x90 ) > >( __LINE__, __FILE__, data );
+      test_scan< ranges< char( 0x80 ), char( 0xff ), '0', '9' > >( __LINE__, __FILE__, data );
+      test_scan< any >( __LINE__, __FILE__, data );
+
+      test_star< digit >( __LINE__, __FILE__, "", 0, 0 );
+      test_star< digit >( __LINE__, __FILE__, "a", 0, 0 );
+      test_star< digit >( __LINE__, __FILE__, "1", 1, 0 );
+      test_star< digit >( __LINE__, __FILE__, std::string( 100, '7' ) + "x7", 100, 0 );
+      test_star< space >( __LINE__, __FILE__, " \n\t\n" + std::string( 50, ' ' ) + "\n x", 56, 3 );
+      test_star< not_one< '"' > >( __LINE__, __FILE__, std::string( 40, '\n' ) + "\"", 40, 40 );
+      test_star< any >( __LINE__, __FILE__, std::string( 33, '\n' ), 33, 33 );
+
+      std::size_t count = 0;
+      memory_input in( "1234567890123456789012345678901234567890x", __FUNCTION__ );
+      TAO_PEGTL_TEST_ASSERT( parse< plus< digit >, test_action >( in, count ) );
+      TAO_PEGTL_TEST_ASSERT( count == 40 );
+   }
+
+}  // namespace tao::pegtl
+
+#include "main.hpp"
@@ -0,0 +1,84 @@
+// Copyright (c) 2023 Dr. Colin Hirsch and Daniel Frey
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+#include "test.hpp"
+#include "verify_rule.hpp"
+
+namespace tao::pegtl
+{
+   template< typename Rule >
+   inline constexpr bool elided = ( internal::rewind_elision< Rule, apply_mode::action, rewind_mode::required, nothing, normal > == rewind_mode::dontcare );
+
+   using stars = star< one< 'b' > >;
+
+   template< typename Rule >
+   struct my_action
+      : nothing< Rule >
+   {};
+
+   template<>
+   struct my_action< stars >
+   {
+      template< typename ActionInput >
+      static bool apply( const ActionInput& in )
+      {
+         return in.size() < 2;
+      }
+   };
+
+   template< typename Rule >
+   struct my_control
+      : normal< Rule >
+   {};
+
+   void unit_test()
+   {
+      static_assert( elided< any > );
+      static_assert( elided< eof > );
+      static_assert( elided< one< 'a' > > );
+      static_assert( elided< string< 'a', 'b' > > );
+      static_assert( elided< keywords< TAO_PEGTL_STRING( "if" ) > > );
+      static_assert( elided< opt< one< 'a' >, one< 'b' > > > );
+      static_assert( elided< star< one< 'a' >, one< 'b' > > > );
+      static_assert( elided< plus< one< 'a' > > > );
+      static_assert( elided< identifier > );
+      static_assert( elided< seq< one< 'a' > > > );
+      static_assert( elided< seq< string< 'a', 'b' >, star< one< 'c' > >, opt< one< 'd' > > > > );
+      static_assert( elided< seq< at< one< 'a' > >, not_at< one< 'b' > >, one< 'c' > > > );
+      static_assert( elided< sor< seq< one< 'a' >, one< 'b' > >, one< 'c' > > > );
+      static_assert( elided< rep< 1, string< 'a', 'b' > > > );
+      static_assert( elided< rep< 3, opt< one< 'a' > > > > );
+
+      static_assert( !elided< seq< one< 'a' >, one< 'b' > > > );
+      static_assert( !elided< seq< one< 'a' >, plus< one< 'b' > > > > );
+      static_assert( !elided< sor< one< 'c' >, seq< one< 'a' >, one< 'b' > > > > );
+      static_assert( !elided< plus< one< 'a' >, one< 'b' > > > );
+      static_assert( !elided< rep< 2, one< 'a' > > > );
+      static_assert( !elided< until< one< 'a' > > > );
+      static_assert( !elided< must< one< 'a' > > > );
+
+      static_assert( internal::rewind_elision< seq< one< 'a' >, stars >, apply_mode::nothing, rewind_mode::required, my_action, normal > == rewind_mode::dontcare );
+      static_assert( internal::rewind_elision< seq< one< 'a' >, stars >, apply_mode::action, rewind_mode::required, my_action, normal > == rewind_mode::required );
+      static_assert( internal::rewind_elision< seq< one< 'a' >, stars >, apply_mode::action, rewind_mode::required, nothing, my_control > == rewind_mode::required );
+      static_assert( internal::rewind_elision< seq< one< 'a' > >, apply_mode::action, rewind_mode::active, nothing, normal > == rewind_mode::active );
+
+      verify_rule< sor< seq< string< 'a', 'b' >, star< one< 'c' > > >, seq< one< 'a' >, one< 'x' > > > >( __LINE__, __FILE__, "abcc", result_type::success, 0 );
+      verify_rule< sor< seq< string< 'a', 'b' >, star< one< 'c' > > >, seq< one< 'a' >, one< 'x' > > > >( __LINE__, __FILE__, "axcc", result_type::success, 2 );
+      verify_rule< sor< seq< one< 'a' >, one< 'b' > >, seq< one< 'a' >, one< 'x' > > > >( __LINE__, __FILE__, "axb", result_type::success, 1 );
+      verify_rule< sor< seq< string< 'a', 'b' >, opt< one< 'c' > > >, one< 'a' > > >( __LINE__, __FILE__, "ax", result_type::success, 1 );
+
+      {
+         using grammar = seq< sor< seq< one< 'a' >, stars >, seq< one< 'a' >, any, any > >, eof >;
+         memory_input in( "abb", __FUNCTION__ );
+         TAO_PEGTL_TEST_ASSERT( parse< grammar, my_action >( in ) );
+         memory_input i2( "ab", __FUNCTION__ );
+         TAO_PEGTL_TEST_ASSERT( parse< grammar, my_action >( i2 ) );
+         memory_input i3( "abbb", __FUNCTION__ );
+         TAO_PEGTL_TEST_ASSERT( !parse< grammar, my_action >( i3 ) );
+      }
+   }
+
+}  // namespace tao::pegtl
+
+#include "main.hpp"
@@ -0,0 +1,115 @@
+// Copyright (c) 2023 Dr. Colin Hirsch and Daniel Frey
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+#if defined( __unix__ ) || ( defined( __APPLE__ ) && defined( __MACH__ ) )
+#include <unistd.h>  // Required for _POSIX_MAPPED_FILES
+#endif
+
+#if !defined( _POSIX_MAPPED_FILES )
+#include <iostream>
+int main()
+{
+   std::cout << "Sliding mmap window not supported on this platform, skipping test..." << std::endl;
+}
+#else
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#include "test.hpp"
+
+#include <tao/pegtl/mmap_window_input.hpp>
+
+namespace tao::pegtl
+{
+   struct test_line
+      : seq< plus< digit >, eol >
+   {};
+
+   template< typename Rule >
+   struct test_action
+      : nothing< Rule >
+   {};
+
+   template<>
+   struct test_action< test_line >
+   {
+      template< typename ActionInput >
+      static void apply( const ActionInput& in, std::string& s, std::size_t& lines )
+      {
+         s += in.string();
+         lines = in.input().line();
+      }
+   };
+
+   struct temporary_file
+   {
+      explicit temporary_file( const std::string& data )
+      {
+         const int fd = ::mkstemp( name );
+         TAO_PEGTL_TEST_ASSERT( fd >= 0 );
+         TAO_PEGTL_TEST_ASSERT( ::write( fd, data.data(), data.size() ) == ssize_t( data.size() ) );
+         ::close( fd );
+      }
+
+      temporary_file( const temporary_file& ) = delete;
+      temporary_file( temporary_file&& ) = delete;
+
+      ~temporary_file()
+      {
+         ::unlink( name );
+      }
+
+      temporary_file& operator=( const temporary_file& ) = delete;
+      temporary_file& operator=( temporary_file&& ) = delete;
+
+      char name[ 32 ] = "/tmp/tao-pegtl-test-XXXXXX";
+   };
+
+   void unit_test()
+   {
+      const temporary_file empty( "" );
+      mmap_window_input<> i0( empty.name, 100 );
+      TAO_PEGTL_TEST_ASSERT( parse< eof >( i0 ) );
+      TAO_PEGTL_TEST_ASSERT( i0.source() == empty.name );
+
+      std::string data;
+      for( std::size_t i = 0; i < 20000; ++i ) {
+         data += std::to_string( i * 7919 ) + '\n';
+      }
+      const temporary_file lines_file( data );
+      {
+         std::string copy;
+         std::size_t lines = 0;
+         mmap_window_input<> in( lines_file.name, 100, "lines" );
+         TAO_PEGTL_TEST_ASSERT( in.buffer_capacity() < data.size() );
+         TAO_PEGTL_TEST_ASSERT( parse< until< eof, test_line, discard >, test_action >( in, copy, lines ) );
+         TAO_PEGTL_TEST_ASSERT( copy == data );
+         TAO_PEGTL_TEST_ASSERT( lines == 20001 );
+         TAO_PEGTL_TEST_ASSERT( in.byte() == data.size() );
+         TAO_PEGTL_TEST_ASSERT( in.position().source == "lines" );
+      }
+      {
+         mmap_window_input<> in( lines_file.name, 100 );
+         for( std::size_t i = 0; i < data.size(); ++i ) {
+            in.require( 1 );
+            TAO_PEGTL_TEST_ASSERT( in.peek_char() == data[ i ] );
+            in.bump();
+            in.discard();
+            TAO_PEGTL_TEST_ASSERT( in.size( 100 ) >= ( std::min )( std::size_t( 100 ), data.size() - i - 1 ) );
+         }
+         TAO_PEGTL_TEST_ASSERT( in.empty() );
+      }
+#if defined( __cpp_exceptions )
+      mmap_window_input<> in( lines_file.name, 100 );
+      TAO_PEGTL_TEST_THROWS( parse< star< test_line > >( in ) );
+#endif
+   }
+
+}  // namespace tao::pegtl
+
+#include "main.hpp"
+
+#endif
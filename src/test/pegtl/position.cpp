@@ -10,6 +10,9 @@ int main()
 }
 #else
 
+#include <string>
+#include <vector>
+
 #include "test.hpp"
 
 #include <tao/pegtl/internal/cstring_reader.hpp>
@@ -141,6 +144,22 @@ namespace tao::pegtl
       TAO_PEGTL_TEST_ASSERT( q.source == s );
    }
 
+   template< tracking_mode P, typename Eol >
+   void test_lazy( const std::size_t byte, const std::size_t line, const std::size_t column )
+   {
+      const std::string s = "ab\ncd\n\nefg\r\nh\n";
+      memory_input< tracking_mode::eager, Eol > i1( s.data(), s.data() + s.size(), __FUNCTION__, byte, line, column );
+      memory_input< P, Eol > i2( s.data(), s.data() + s.size(), __FUNCTION__, byte, line, column );
+      std::vector< position > ps;
+      for( std::size_t i = 0; i <= s.size(); ++i ) {
+         ps.emplace_back( i1.position() );
+         i1.bump();
+      }
+      for( const std::size_t i : { 5, 2, 0, 13, 7, 7, 3, 14, 1, 9, 6, 4, 8, 10, 11, 12 } ) {
+         TAO_PEGTL_TEST_ASSERT( i2.position( s.data() + i ) == ps[ i ] );
+      }
+   }
+
    void unit_test()
    {
       test_matches_lf< any >();
@@ -210,6 +229,13 @@ namespace tao::pegtl
       test_nested< buffer_input_t >();
 
       test_frobnicator();
+
+      test_lazy< tracking_mode::lazy, eol::lf_crlf >( 0, 1, 1 );
+      test_lazy< tracking_mode::lazy, eol::lf_crlf >( 20, 4, 7 );
+      test_lazy< tracking_mode::lazy, eol::cr >( 20, 4, 7 );
+      test_lazy< tracking_mode::indexed, eol::lf_crlf >( 0, 1, 1 );
+      test_lazy< tracking_mode::indexed, eol::lf_crlf >( 20, 4, 7 );
+      test_lazy< tracking_mode::indexed, eol::cr >( 20, 4, 7 );
    }
 
 }  // namespace tao::pegtl
@@ -0,0 +1,92 @@
+// Copyright (c) 2023 Dr. Colin Hirsch and Daniel Frey
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined( __unix__ ) && !( defined( __APPLE__ ) && defined( __MACH__ ) )
+#include <iostream>
+int main()
+{
+   std::cout << "Ring buffer not supported on this platform, skipping test..." << std::endl;
+}
+#else
+
+#include <string>
+
+#include "test.hpp"
+
+#include <tao/pegtl/ring_buffer_input.hpp>
+#include <tao/pegtl/internal/cstring_reader.hpp>
+
+namespace tao::pegtl
+{
+   template< typename Rule, template< typename... > class Action = nothing, typename... States >
+   bool parse_cstring( const char* string, const char* source, const std::size_t maximum, States&&... st )
+   {
+      ring_buffer_input< internal::cstring_reader > in( source, maximum, string );
+      return parse< Rule, Action >( in, st... );
+   }
+
+   struct test_line
+      : seq< plus< digit >, eol >
+   {};
+
+   template< typename Rule >
+   struct test_action
+      : nothing< Rule >
+   {};
+
+   template<>
+   struct test_action< test_line >
+   {
+      template< typename ActionInput >
+      static void apply( const ActionInput& in, std::string& s, std::size_t& lines )
+      {
+         s += in.string();
+         lines = in.input().line();
+      }
+   };
+
+   template<>
+   struct test_action< plus< alpha > >
+      : discard_input
+   {};
+
+   void unit_test()
+   {
+      TAO_PEGTL_TEST_ASSERT( parse_cstring< seq< string< 'a', 'b', 'c' >, eof > >( "abc", TAO_TEST_LINE, 1 ) );
+      TAO_PEGTL_TEST_ASSERT( parse_cstring< seq< string< 'a', 'b', 'c' >, eof > >( "abc", TAO_TEST_LINE, 128 ) );
+
+      std::string data;
+      for( std::size_t i = 0; i < 20000; ++i ) {
+         data += std::to_string( i * 7919 ) + '\n';
+      }
+      std::string copy;
+      std::size_t lines = 0;
+      TAO_PEGTL_TEST_ASSERT( parse_cstring< until< eof, test_line, discard >, test_action >( data.c_str(), TAO_TEST_LINE, 100, copy, lines ) );
+      TAO_PEGTL_TEST_ASSERT( copy == data );
+      TAO_PEGTL_TEST_ASSERT( lines == 20001 );
+
+      const std::string alphas( 100000, 'x' );
+      ring_buffer_input< internal::cstring_reader > in( TAO_TEST_LINE, 100, alphas.c_str() );
+      TAO_PEGTL_TEST_ASSERT( in.buffer_capacity() >= 100 + in.chunk_size );
+      for( std::size_t i = 0; i < alphas.size(); ++i ) {
+         in.require( 1 );
+         TAO_PEGTL_TEST_ASSERT( in.peek_char() == 'x' );
+         in.bump();
+         in.discard();
+         TAO_PEGTL_TEST_ASSERT( in.buffer_free_before_current() == 0 );
+      }
+      TAO_PEGTL_TEST_ASSERT( in.empty() );
+      TAO_PEGTL_TEST_ASSERT( in.byte() == alphas.size() );
+
+#if defined( __cpp_exceptions )
+      TAO_PEGTL_TEST_THROWS( parse_cstring< plus< alpha > >( alphas.c_str(), TAO_TEST_LINE, 100 ) );
+#endif
+      TAO_PEGTL_TEST_ASSERT( parse_cstring< star< plus< alpha >, one< ' ' > >, test_action >( ( alphas.substr( 0, 3000 ) + ' ' + alphas.substr( 0, 3000 ) + ' ' ).c_str(), TAO_TEST_LINE, 3100 ) );
+   }
+
+}  // namespace tao::pegtl
+
+#include "main.hpp"
+
+#endif
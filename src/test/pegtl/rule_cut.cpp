@@ -0,0 +1,101 @@
+// Copyright (c) 2023 Dr. Colin Hirsch and Daniel Frey
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined( __cpp_exceptions )
+#include <iostream>
+int main()
+{
+   std::cout << "Exception support disabled, skipping test..." << std::endl;
+}
+#else
+
+#include <string>
+
+#include "test.hpp"
+
+#include "verify_meta.hpp"
+#include "verify_rule.hpp"
+
+#include <tao/pegtl/contrib/coverage.hpp>
+#include <tao/pegtl/internal/cstring_reader.hpp>
+
+namespace tao::pegtl
+{
+   using record = seq< one< 'r' >, cut, until< eol > >;
+
+   template< typename Rule >
+   struct max_buffered
+      : nothing< Rule >
+   {};
+
+   template<>
+   struct max_buffered< eol >
+   {
+      template< typename ActionInput >
+      static void apply( const ActionInput& in, std::size_t& m )
+      {
+         m = ( std::max )( m, in.input().buffer_occupied() + in.input().buffer_free_before_current() );
+      }
+   };
+
+   void unit_test()
+   {
+      verify_meta< cut, internal::cut >();
+
+      verify_analyze< cut >( __LINE__, __FILE__, false, false );
+      verify_analyze< seq< one< 'a' >, cut, one< 'b' > > >( __LINE__, __FILE__, true, false );
+
+      verify_rule< cut >( __LINE__, __FILE__, "", result_type::success, 0 );
+      verify_rule< cut >( __LINE__, __FILE__, "a", result_type::success, 1 );
+
+      verify_rule< seq< one< 'a' >, cut, one< 'b' > > >( __LINE__, __FILE__, "", result_type::local_failure, 0 );
+      verify_rule< seq< one< 'a' >, cut, one< 'b' > > >( __LINE__, __FILE__, "b", result_type::local_failure, 1 );
+      verify_rule< seq< one< 'a' >, cut, one< 'b' > > >( __LINE__, __FILE__, "a", result_type::global_failure, 0 );
+      verify_rule< seq< one< 'a' >, cut, one< 'b' > > >( __LINE__, __FILE__, "ac", result_type::global_failure, 1 );
+      verify_rule< seq< one< 'a' >, cut, one< 'b' > > >( __LINE__, __FILE__, "ab", result_type::success, 0 );
+      verify_rule< seq< one< 'a' >, cut, one< 'b' > > >( __LINE__, __FILE__, "abc", result_type::success, 1 );
+
+      verify_rule< seq< one< 'a' >, one< 'b' >, cut > >( __LINE__, __FILE__, "ab", result_type::success, 0 );
+      verify_rule< seq< one< 'a' >, one< 'b' >, cut > >( __LINE__, __FILE__, "ac", result_type::local_failure, 2 );
+      verify_rule< seq< cut, one< 'a' > > >( __LINE__, __FILE__, "b", result_type::global_failure, 1 );
+
+      // The cut prevents the sor from trying the second alternative.
+      verify_rule< sor< seq< one< 'a' >, cut, one< 'b' > >, seq< one< 'a' >, one< 'c' > > > >( __LINE__, __FILE__, "ab", result_type::success, 0 );
+      verify_rule< sor< seq< one< 'a' >, cut, one< 'b' > >, seq< one< 'a' >, one< 'c' > > > >( __LINE__, __FILE__, "ac", result_type::global_failure, 1 );
+      verify_rule< sor< seq< one< 'x' >, cut, one< 'b' > >, seq< one< 'a' >, one< 'c' > > > >( __LINE__, __FILE__, "ac", result_type::success, 0 );
+
+      // Records that are much longer in total than the buffer can be parsed because the cut discards them.
+      std::string data;
+      for( std::size_t i = 0; i < 1000; ++i ) {
+         data += "record " + std::to_string( i ) + '\n';
+      }
+      {
+         buffer_input< internal::cstring_reader > in( "cut", 100, data.c_str() );
+         std::size_t m = 0;
+         TAO_PEGTL_TEST_ASSERT( parse< seq< star< record >, eof >, max_buffered >( in, m ) );
+         TAO_PEGTL_TEST_ASSERT( m <= in.buffer_capacity() );
+      }
+      {
+         buffer_input< internal::cstring_reader > in( "cut", 100, data.c_str() );
+         TAO_PEGTL_TEST_THROWS( parse< seq< star< seq< one< 'r' >, until< eol > > >, eof > >( in ) );
+      }
+      {
+         // No discard while an enclosing rule can still rewind.
+         buffer_input< internal::cstring_reader > in( "cut", 100, data.c_str() );
+         TAO_PEGTL_TEST_THROWS( parse< seq< at< star< record > >, star< record >, eof > >( in ) );
+      }
+      {
+         // Only sub-rules of the seq are called via the control.
+         memory_input in( "ab", __FUNCTION__ );
+         coverage_result result;
+         TAO_PEGTL_TEST_ASSERT( coverage< seq< one< 'a' >, cut, one< 'b' > > >( in, result ) );
+         TAO_PEGTL_TEST_ASSERT( result.at( demangle< one< 'b' > >() ).success == 1 );
+      }
+   }
+
+}  // namespace tao::pegtl
+
+#include "main.hpp"
+
+#endif
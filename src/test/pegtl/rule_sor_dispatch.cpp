@@ -0,0 +1,122 @@
+// Copyright (c) 2023 Dr. Colin Hirsch and Daniel Frey
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+#include <string>
+#include <type_traits>
+
+#include "test.hpp"
+
+#include "verify_meta.hpp"
+#include "verify_rule.hpp"
+
+namespace tao::pegtl
+{
+   std::size_t keyword_starts = 0;
+
+   struct test_keyword
+      : string< 'f', 'o', 'r' >
+   {};
+
+   template< typename Rule >
+   struct test_control
+      : normal< Rule >
+   {
+      template< typename ParseInput, typename... States >
+      static void start( const ParseInput& /*unused*/, States&&... /*unused*/ ) noexcept
+      {
+         if constexpr( std::is_same_v< Rule, test_keyword > ) {
+            ++keyword_starts;
+         }
+      }
+   };
+
+   // A custom rule without rule_t is always attempted.
+
+   struct test_custom
+   {
+      template< typename ParseInput >
+      [[nodiscard]] static bool match( ParseInput& in )
+      {
+         if( ( !in.empty() ) && ( in.peek_char() == 'c' ) ) {
+            in.bump( 1 );
+            return true;
+         }
+         return false;
+      }
+   };
+
+   using test_grammar = sor_dispatch< test_keyword, seq< opt< one< '-' > >, plus< digit > >, istring< 'i', 'f' >, star< one< '+' > > >;
+
+   void unit_test()
+   {
+      static_assert( internal::first_of< one< 'a', 'b' > >().bytes[ 'a' ] );
+      static_assert( !internal::first_of< one< 'a', 'b' > >().bytes[ 'c' ] );
+      static_assert( !internal::first_of< one< 'a', 'b' > >().empty );
+      static_assert( !internal::first_of< not_one< 'a' > >().bytes[ 'a' ] );
+      static_assert( internal::first_of< not_one< 'a' > >().bytes[ 0xff ] );
+      static_assert( internal::first_of< string< 'a', 'b' > >().bytes[ 'a' ] );
+      static_assert( !internal::first_of< string< 'a', 'b' > >().bytes[ 'b' ] );
+      static_assert( internal::first_of< istring< 'a', 'b' > >().bytes[ 'A' ] );
+      static_assert( internal::first_of< seq< opt< one< '-' > >, digit > >().bytes[ '-' ] );
+      static_assert( internal::first_of< seq< opt< one< '-' > >, digit > >().bytes[ '7' ] );
+      static_assert( !internal::first_of< seq< opt< one< '-' > >, digit > >().bytes[ 'x' ] );
+      static_assert( !internal::first_of< seq< opt< one< '-' > >, digit > >().empty );
+      static_assert( internal::first_of< star< alpha > >().empty );
+      static_assert( internal::first_of< eof >().bytes[ 'x' ] );
+      static_assert( internal::first_of< eof >().empty );
+      static_assert( internal::first_of< test_custom >().bytes[ 'x' ] );
+      static_assert( internal::first_of< test_custom >().empty );
+
+      verify_meta< sor_dispatch<>, internal::failure >();
+      verify_meta< sor_dispatch< alpha >, internal::sor_dispatch< alpha >, alpha >();
+      verify_meta< sor_dispatch< alpha, digit >, internal::sor_dispatch< alpha, digit >, alpha, digit >();
+
+      verify_analyze< sor_dispatch< eof > >( __LINE__, __FILE__, false, false );
+      verify_analyze< sor_dispatch< any > >( __LINE__, __FILE__, true, false );
+      verify_analyze< sor_dispatch< any, eof > >( __LINE__, __FILE__, false, false );
+      verify_analyze< sor_dispatch< any, any > >( __LINE__, __FILE__, true, false );
+
+      verify_rule< sor_dispatch<> >( __LINE__, __FILE__, "", result_type::local_failure, 0 );
+      verify_rule< sor_dispatch<> >( __LINE__, __FILE__, "a", result_type::local_failure, 1 );
+
+      verify_rule< sor_dispatch< one< 'a' >, one< 'b' > > >( __LINE__, __FILE__, "", result_type::local_failure, 0 );
+      verify_rule< sor_dispatch< one< 'a' >, one< 'b' > > >( __LINE__, __FILE__, "a", result_type::success, 0 );
+      verify_rule< sor_dispatch< one< 'a' >, one< 'b' > > >( __LINE__, __FILE__, "b", result_type::success, 0 );
+      verify_rule< sor_dispatch< one< 'a' >, one< 'b' > > >( __LINE__, __FILE__, "c", result_type::local_failure, 1 );
+      verify_rule< sor_dispatch< one< 'a' >, one< 'b' > > >( __LINE__, __FILE__, "ab", result_type::success, 1 );
+      verify_rule< sor_dispatch< one< 'a' >, one< 'b' > > >( __LINE__, __FILE__, "cb", result_type::local_failure, 2 );
+
+      verify_rule< test_grammar >( __LINE__, __FILE__, "", result_type::success, 0 );
+      verify_rule< test_grammar >( __LINE__, __FILE__, "for", result_type::success, 0 );
+      verify_rule< test_grammar >( __LINE__, __FILE__, "fo", result_type::success, 2 );
+      verify_rule< test_grammar >( __LINE__, __FILE__, "-12", result_type::success, 0 );
+      verify_rule< test_grammar >( __LINE__, __FILE__, "-x", result_type::success, 2 );
+      verify_rule< test_grammar >( __LINE__, __FILE__, "IF", result_type::success, 0 );
+      verify_rule< test_grammar >( __LINE__, __FILE__, "++x", result_type::success, 1 );
+      verify_rule< test_grammar >( __LINE__, __FILE__, "x", result_type::success, 1 );
+
+      verify_rule< sor_dispatch< one< 'a' >, seq< one< 'b' >, eof >, eof > >( __LINE__, __FILE__, "", result_type::success, 0 );
+      verify_rule< sor_dispatch< one< 'a' >, seq< one< 'b' >, eof >, eof > >( __LINE__, __FILE__, "b", result_type::success, 0 );
+      verify_rule< sor_dispatch< one< 'a' >, seq< one< 'b' >, eof >, eof > >( __LINE__, __FILE__, "c", result_type::local_failure, 1 );
+#if defined( __cpp_exceptions )
+      verify_rule< sor_dispatch< one< 'a' >, must< one< 'b' > > > >( __LINE__, __FILE__, "c", result_type::global_failure, 1 );
+#endif
+
+      {
+         memory_input in( "c", __FUNCTION__ );
+         TAO_PEGTL_TEST_ASSERT( parse< sor_dispatch< one< 'a' >, test_custom > >( in ) );
+         TAO_PEGTL_TEST_ASSERT( in.empty() );
+      }
+
+      for( const char* s : { "for", "if", "-1", "", "x" } ) {
+         keyword_starts = 0;
+         memory_input in( s, __FUNCTION__ );
+         TAO_PEGTL_TEST_ASSERT( parse< test_grammar, nothing, test_control >( in ) );
+         TAO_PEGTL_TEST_ASSERT( keyword_starts == ( ( s[ 0 ] == 'f' ) ? 1 : 0 ) );
+      }
+   }
+
+}  // namespace tao::pegtl
+
+#include "main.hpp"
@@ -2,6 +2,9 @@
 // Distributed under the Boost Software License, Version 1.0.
 // (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
 
+#include <cstddef>
+#include <string>
+
 #include "test.hpp"
 #include "verify_meta.hpp"
 #include "verify_rule.hpp"
@@ -37,8 +40,58 @@ namespace tao::pegtl
       }
    };
 
+   template< typename Rule >
+   struct my_count
+      : nothing< Rule >
+   {};
+
+   template<>
+   struct my_count< one< 'a' > >
+   {
+      static void apply0( bool& /*unused*/, std::size_t& count )
+      {
+         ++count;
+      }
+   };
+
+   template< typename Rule >
+   struct my_control
+      : normal< Rule >
+   {};
+
+   template< typename Rule, typename ParseInput >
+   void verify_skip( const std::size_t line, const char* file, const std::string& data )
+   {
+      ParseInput a( data, file );
+      ParseInput b( data, file );
+      const bool r = parse< Rule >( a );
+      if( ( r != parse< Rule, nothing, my_control >( b ) ) || ( a.byte() != b.byte() ) || ( a.position() != b.position() ) ) {
+         TAO_PEGTL_TEST_FAILED( "skipping until differs from bytewise until at " << a.position() << " vs. " << b.position() );  // LCOV_EXCL_LINE
+      }
+   }
+
+   template< typename Cond >
+   void verify_skip( const std::size_t line, const char* file, const std::string& data )
+   {
+      static_assert( !internal::until_skip_enabled< Cond, apply_mode::action, nothing, my_control, eol::lf_crlf >() );
+      for( std::size_t i = 0; i < data.size(); ++i ) {
+         verify_skip< until< Cond >, memory_input<> >( line, file, data.substr( i ) );
+         verify_skip< until< Cond >, memory_input< tracking_mode::lazy > >( line, file, data.substr( i ) );
+      }
+   }
+
    void unit_test()
    {
+      static_assert( internal::until_skip_enabled< one< 'a' >, apply_mode::action, nothing, normal, eol::lf_crlf >() );
+      static_assert( internal::until_skip_enabled< string< '*', '/' >, apply_mode::action, nothing, normal, eol::lf_crlf >() );
+      static_assert( internal::until_skip_enabled< at< one< 'a', 'b' > >, apply_mode::action, nothing, normal, eol::lf_crlf >() );
+      static_assert( internal::until_skip_enabled< eolf, apply_mode::action, nothing, normal, eol::lf_crlf >() );
+      static_assert( internal::until_skip_enabled< one< 'a' >, apply_mode::nothing, my_count, normal, eol::lf_crlf >() );
+      static_assert( !internal::until_skip_enabled< one< 'a' >, apply_mode::action, my_count, normal, eol::lf_crlf >() );
+      static_assert( !internal::until_skip_enabled< eof, apply_mode::action, nothing, normal, eol::lf_crlf >() );
+      static_assert( !internal::until_skip_enabled< opt< one< 'a' > >, apply_mode::action, nothing, normal, eol::lf_crlf >() );
+      static_assert( !internal::until_skip_enabled< seq< one< 'a' > >, apply_mode::action, nothing, normal, eol::lf_crlf >() );
+
       verify_analyze< until< eof > >( __LINE__, __FILE__, false, false );
       verify_analyze< until< any > >( __LINE__, __FILE__, true, false );
       verify_analyze< until< eof, any > >( __LINE__, __FILE__, false, false );
@@ -112,6 +165,25 @@ namespace tao::pegtl
       verify_rule< try_catch< must< until< one< 'a' >, one< 'b' > > > > >( __LINE__, __FILE__, "bbbc", result_type::local_failure, 4 );
 #endif
 
+      verify_rule< until< string< '*', '/' > > >( __LINE__, __FILE__, "*/", result_type::success, 0 );
+      verify_rule< until< string< '*', '/' > > >( __LINE__, __FILE__, "** * / **/ x", result_type::success, 2 );
+      verify_rule< until< string< '*', '/' > > >( __LINE__, __FILE__, "** * / ** /", result_type::local_failure, 11 );
+      verify_rule< until< eolf > >( __LINE__, __FILE__, "abc", result_type::success, 0 );
+      verify_rule< until< eolf > >( __LINE__, __FILE__, "a\rb\r\nc", result_type::success, 1 );
+      verify_rule< until< at< one< 'x', 'y' > > > >( __LINE__, __FILE__, "abcdefghijklmnopqrstuvwy", result_type::success, 1 );
+      verify_rule< until< at< one< 'x', 'y' > > > >( __LINE__, __FILE__, "abcdefghijklmnopqrstuvw", result_type::local_failure, 23 );
+
+      const std::string text = "/* a\n\n" + std::string( 100, '*' ) + "\n" + std::string( 100, ' ' ) + "*/x";
+      verify_skip< string< '*', '/' > >( __LINE__, __FILE__, text );
+      verify_skip< eolf >( __LINE__, __FILE__, text );
+      verify_skip< one< 'x' > >( __LINE__, __FILE__, text );
+      verify_skip< at< one< 'x', '\n' > > >( __LINE__, __FILE__, text );
+
+      std::size_t count = 0;
+      bool flag = false;
+      TAO_PEGTL_TEST_ASSERT( parse< until< one< 'a' > >, my_count >( memory_input( "bbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbba", __FUNCTION__ ), flag, count ) );
+      TAO_PEGTL_TEST_ASSERT( count == 1 );
+
       bool success = false;
       const bool result = parse< until< my_rule, eof >, my_action >( memory_input<>( "", __FUNCTION__ ), success );
       TAO_PEGTL_TEST_ASSERT( result );
@@ -2,6 +2,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
 
+#include <cstddef>
 #include <string>
 #include <vector>
 
@@ -25,6 +26,24 @@ namespace tao::pegtl
       std::vector< std::string > names;
       visit< grammar, visitor >( names );
       TAO_PEGTL_TEST_ASSERT( names.size() == 7 );
+
+      static_assert( rule_list_t< grammar >::size == 7 );
+      static_assert( rule_id_v< grammar, grammar > < 7 );
+      static_assert( rule_id_v< grammar, digit > < 7 );
+      static_assert( rule_id_v< grammar, grammar > != rule_id_v< grammar, digit > );
+      static_assert( rule_id< grammar, alpha >::value == rule_id_v< grammar, alpha > );
+      TAO_PEGTL_TEST_ASSERT( rule_name< grammar >( rule_id_v< grammar, space > ) == demangle< space >() );
+
+      std::vector< bool > seen( 7, false );
+      for( const auto& name : names ) {
+         std::size_t id = 0;
+         while( ( id < 7 ) && ( rule_name< grammar >( id ) != name ) ) {
+            ++id;
+         }
+         TAO_PEGTL_TEST_ASSERT( id < 7 );
+         TAO_PEGTL_TEST_ASSERT( !seen[ id ] );
+         seen[ id ] = true;
+      }
    }
 
 }  // namespace tao::pegtl